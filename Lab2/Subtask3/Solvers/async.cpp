@@ -0,0 +1,52 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+
+#include "linalg.h"
+#include "stencil.h"
+#include "async.h"
+
+// Запуск: ./async [nx] [ny] [nz]
+// Сравнивает обычный Якоби (барьер и глобальная норма на каждом проходе)
+// с асинхронной релаксацией без барьеров на задаче Пуассона.
+int main(int argc, char** argv) {
+    const int nx = (argc > 1) ? std::atoi(argv[1]) : 64;
+    const int ny = (argc > 2) ? std::atoi(argv[2]) : nx;
+    const int nz = (argc > 3) ? std::atoi(argv[3]) : nx;
+
+    Poisson A(nx, ny, nz);
+    const double h = 1.0 / (nx + 1);
+    Field f = makeField(A, h * h);
+    std::vector<double> B(f.begin(), f.end());
+
+    double epsilon = 0.00001;
+    long maxSweeps = 10000000;
+
+    std::ofstream file("async.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    for (int i = 0; i < 20; i++) {
+        Field u = makeField(A);
+        auto start = std::chrono::steady_clock::now();
+        SolveStats sync = poissonJacobi(A, f, u, epsilon, static_cast<int>(maxSweeps), 1, false);
+        std::chrono::duration<double> sync_seconds = std::chrono::steady_clock::now() - start;
+
+        std::vector<double> x(A.n, 0.0);
+        start = std::chrono::steady_clock::now();
+        AsyncStats async = asyncRelax(A, B, x, 1.0, epsilon, maxSweeps);
+        std::chrono::duration<double> async_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Jacobi: " << sync.iterations << " sweeps, " << sync_seconds.count() << " s" << std::endl;
+        std::cout << "Async: " << async.minSweeps << "-" << async.maxSweeps << " sweeps per thread, "
+                  << async_seconds.count() << " s, error: " << async.error << std::endl;
+        file << sync_seconds.count() << "," << async_seconds.count() << std::endl;
+    }
+
+    file.close();
+    return 0;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include "linalg.h"
+#include "richardson.h"
+
+// Доступ к общему вектору без синхронизации: relaxed-чтение того значения,
+// которое сейчас лежит в памяти (своё или соседа, старое или уже новое)
+struct RelaxedView {
+    const std::atomic<double>* p;
+
+    double operator[](size_t i) const { return p[i].load(std::memory_order_relaxed); }
+};
+
+// Состояние потока для децентрализованного контроля сходимости,
+// по одной кэш-линии на поток, чтобы не было ложного разделения
+struct alignas(64) AsyncSlot {
+    std::atomic<double> residual{0.0};  // ||r||^2 по своим строкам на последнем проходе
+    std::atomic<long> sweeps{0};
+};
+
+struct AsyncStats {
+    long minSweeps = 0;   // проходов у самого медленного потока
+    long maxSweeps = 0;   // проходов у самого быстрого потока
+    double error = 0.0;   // честная невязка ||B - Ax|| / ||B|| после остановки
+};
+
+// Асинхронная (хаотическая) релаксация: каждый поток без барьеров снова и снова
+// обновляет свой блок строк, x_i += omega (b_i - (A x)_i) / a_ii, читая текущие
+// значения соседей как есть. После каждого прохода поток публикует невязку своего
+// блока и сам складывает опубликованные невязки всех потоков; первый, кто увидел
+// сумму меньше epsilon, поднимает общий флаг остановки. Глобальной редукции
+// и барьеров в цикле нет.
+// Сходится, когда сходится и асинхронный Якоби: например, для матриц
+// с диагональным преобладанием и для Poisson.
+template <typename Matrix>
+AsyncStats asyncRelax(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                      double omega, double epsilon, long maxSweeps) {
+    const int N = A.n;
+    std::vector<std::atomic<double>> shared(N);
+    for (int i = 0; i < N; i++) {
+        shared[i].store(x[i], std::memory_order_relaxed);
+    }
+    const RelaxedView view{shared.data()};
+    const double normB = norm(B);
+    const double threshold = epsilon * epsilon * normB * normB;
+
+    std::vector<double> diag(N);
+    for (int i = 0; i < N; i++) {
+        diag[i] = A.at(i, i);
+    }
+
+    AsyncStats stats;
+    std::vector<double> r(N);
+    do {
+        const int threads = threadsFor("async");
+        std::vector<AsyncSlot> slots(threads);
+        for (AsyncSlot& slot : slots) {
+            slot.residual.store(threshold + 1.0, std::memory_order_relaxed);
+        }
+        std::atomic<bool> done{false};
+
+        #pragma omp parallel num_threads(threads)
+        {
+            const int t = omp_get_thread_num();
+            const int first = static_cast<int>(static_cast<long long>(N) * t / omp_get_num_threads());
+            const int last = static_cast<int>(static_cast<long long>(N) * (t + 1) / omp_get_num_threads());
+            AsyncSlot& mine = slots[t];
+
+            while (!done.load(std::memory_order_relaxed)) {
+                double local = 0.0;
+                for (int i = first; i < last; i++) {
+                    double ri = B[i] - rowDot(A, i, view);
+                    local += ri * ri;
+                    shared[i].store(view[i] + omega * ri / diag[i], std::memory_order_relaxed);
+                }
+                mine.residual.store(local, std::memory_order_relaxed);
+                long sweeps = mine.sweeps.fetch_add(1, std::memory_order_relaxed) + 1;
+
+                double total = 0.0;
+                for (int s = 0; s < omp_get_num_threads(); s++) {
+                    total += slots[s].residual.load(std::memory_order_relaxed);
+                }
+                if (total <= threshold || sweeps >= maxSweeps) {
+                    done.store(true, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        stats.minSweeps = maxSweeps;
+        stats.maxSweeps = 0;
+        for (const AsyncSlot& slot : slots) {
+            stats.minSweeps = std::min(stats.minSweeps, slot.sweeps.load());
+            stats.maxSweeps = std::max(stats.maxSweeps, slot.sweeps.load());
+        }
+        maxSweeps -= stats.maxSweeps;
+
+        // Опубликованные невязки могли быть посчитаны по уже устаревшим значениям,
+        // поэтому после остановки проверяем честно и при необходимости продолжаем
+        for (int i = 0; i < N; i++) {
+            x[i] = shared[i].load(std::memory_order_relaxed);
+        }
+        residual(A, B, x, r);
+        stats.error = norm(r) / normB;
+    } while (stats.error > epsilon && maxSweeps > 0);
+
+    return stats;
+}
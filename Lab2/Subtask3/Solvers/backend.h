@@ -0,0 +1,163 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <numeric>
+#include <execution>
+#include <algorithm>
+#include <cstddef>
+
+#include <omp.h>
+
+#include "tuning.h"
+#include "topology.h"
+#include "thread_pool.h"
+
+/*
+Бэкенды выполнения. Ядро пишется один раз через exec.parallel_for(begin, end, fn) и
+exec.reduce(begin, end, fn), где fn(first, last) обрабатывает полуинтервал (для reduce -
+возвращает частичную сумму), а как делить диапазон и кому его отдать - решает бэкенд:
+  serial - весь диапазон в вызывающем потоке;
+  openmp - omp parallel for по частям, по одной на поток;
+  pool   - ThreadPool (common/thread_pool.h): потоки создаются один раз и живут в бэкенде;
+  pstl   - std::for_each(std::execution::par_unseq) по частям, по 4 на поток
+           (в libstdc++ - поверх TBB, без TBB - последовательно).
+Частичные суммы reduce складываются в порядке частей, поэтому результат одного бэкенда
+не зависит от того, какой поток какую часть посчитал.
+*/
+
+// Общая часть: деление на parts() частей, forEachPart(fn(part)) - у каждого бэкенда свой
+template <typename Backend>
+class BackendBase {
+public:
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, F&& fn) {
+        const int parts = self().parts();
+        self().forEachPart([&](int part) {
+            const size_t first = split(begin, end, part, parts);
+            const size_t last = split(begin, end, part + 1, parts);
+            if (first < last) {
+                fn(first, last);
+            }
+        });
+    }
+
+    template <typename F>
+    double reduce(size_t begin, size_t end, F&& fn) {
+        const int parts = self().parts();
+        std::vector<double> partial(parts, 0.0);
+        self().forEachPart([&](int part) {
+            const size_t first = split(begin, end, part, parts);
+            const size_t last = split(begin, end, part + 1, parts);
+            if (first < last) {
+                partial[part] = fn(first, last);
+            }
+        });
+        double sum = 0.0;
+        for (double p : partial) {
+            sum += p;
+        }
+        return sum;
+    }
+
+private:
+    Backend& self() { return static_cast<Backend&>(*this); }
+
+    static size_t split(size_t begin, size_t end, int part, int parts) {
+        return begin + (end - begin) * part / parts;
+    }
+};
+
+class SerialBackend : public BackendBase<SerialBackend> {
+public:
+    static const char* name() { return "serial"; }
+    int parts() const { return 1; }
+
+    template <typename F>
+    void forEachPart(F&& fn) { fn(0); }
+};
+
+class OpenMPBackend : public BackendBase<OpenMPBackend> {
+public:
+    explicit OpenMPBackend(int threads = NUMBER_OF_THREADS) : threads(threads) {}
+
+    static const char* name() { return "openmp"; }
+    int parts() const { return threads; }
+
+    template <typename F>
+    void forEachPart(F&& fn) {
+        #pragma omp parallel for num_threads(threads) schedule(static)
+        for (int part = 0; part < threads; part++) {
+            fn(part);
+        }
+    }
+
+private:
+    const int threads;
+};
+
+class PoolBackend : public BackendBase<PoolBackend> {
+public:
+    explicit PoolBackend(int threads = NUMBER_OF_THREADS)
+        : callerSaved(pthread_getaffinity_np(pthread_self(), sizeof(caller), &caller) == 0),
+          pool(std::make_unique<ThreadPool>(threads, placementFromEnv(threads))) {}
+
+    ~PoolBackend() {
+        pool.reset();
+        if (callerSaved) {
+            pthread_setaffinity_np(pthread_self(), sizeof(caller), &caller);
+        }
+    }
+
+    static const char* name() { return "pool"; }
+    int parts() const { return pool->size(); }
+
+    template <typename F>
+    void forEachPart(F&& fn) {
+        pool->parallel_for(0, pool->size(), [&](size_t first, size_t last) {
+            for (size_t part = first; part < last; part++) {
+                fn(static_cast<int>(part));
+            }
+        });
+    }
+
+private:
+    // ThreadPool закрепляет вызывающий поток за cpus[0]; прежняя маска возвращается в деструкторе,
+    // иначе потоки, созданные после бэкенда (например, TBB у pstl), унаследуют один процессор
+    cpu_set_t caller;
+    bool callerSaved;
+    std::unique_ptr<ThreadPool> pool;
+};
+
+class ParallelSTLBackend : public BackendBase<ParallelSTLBackend> {
+public:
+    explicit ParallelSTLBackend(int threads = NUMBER_OF_THREADS) : ids(4 * threads) {
+        std::iota(ids.begin(), ids.end(), 0);
+    }
+
+    static const char* name() { return "pstl"; }
+    int parts() const { return static_cast<int>(ids.size()); }
+
+    template <typename F>
+    void forEachPart(F&& fn) {
+        std::for_each(std::execution::par_unseq, ids.begin(), ids.end(), [&](int part) { fn(part); });
+    }
+
+private:
+    std::vector<int> ids;
+};
+
+// Вызвать fn(backend) для каждого бэкенда по очереди: одно и то же ядро на всех
+template <typename F>
+void forEachBackend(int threads, F&& fn) {
+    SerialBackend serial;
+    fn(serial);
+    OpenMPBackend openmp(threads);
+    fn(openmp);
+    {
+        PoolBackend pool(threads);
+        fn(pool);
+    }
+    ParallelSTLBackend pstl(threads);
+    fn(pstl);
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <map>
+#include <functional>
+
+#include "linalg.h"
+#include "spectral.h"
+#include "kernels.h"
+
+// Запуск: ./backends [N] [threads] [repeats]
+// Одни и те же ядра (kernels.h) на всех бэкендах (backend.h): serial, openmp, pool, pstl.
+// Для каждого ядра - лучшее время из repeats запусков на каждом бэкенде и самый быстрый бэкенд.
+
+// Лучшее время из repeats запусков
+static double measure(const std::function<void()>& kernel, int repeats) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        kernel();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const int threads = (argc > 2) ? std::atoi(argv[2]) : NUMBER_OF_THREADS;
+    const int repeats = (argc > 3) ? std::atoi(argv[3]) : 5;
+
+    DenseMatrix A(N);
+    std::vector<double> B(N), x(N, 1.0), y(N);
+    matrixInit(A);
+    vectorInit(B);
+    const double tau = optimalTau(estimateSpectrum(A));
+    const double epsilon = 0.00001;
+
+    std::ofstream file("backends.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    std::map<std::string, std::pair<std::string, double>> fastest;
+    auto report = [&](const std::string& kernel, const std::string& backend, double seconds) {
+        std::cout << kernel << " on " << backend << ": " << seconds << " s" << std::endl;
+        file << N << "," << threads << "," << kernel << "," << backend << "," << seconds << std::endl;
+        if (!fastest.count(kernel) || seconds < fastest[kernel].second) {
+            fastest[kernel] = {backend, seconds};
+        }
+    };
+
+    forEachBackend(threads, [&](auto& exec) {
+        const std::string backend = exec.name();
+        double product = 0.0;
+        report("matvec", backend, measure([&]() { matvec(exec, A, x, y); }, repeats));
+        report("dot", backend, measure([&]() { product = dot(exec, B, x); }, repeats));
+        report("axpy", backend, measure([&]() { axpy(exec, 1e-9, B, y); }, repeats));
+
+        std::vector<double> solution(N, 0.0);
+        SolveStats stats;
+        report("richardson", backend, measure([&]() {
+            std::fill(solution.begin(), solution.end(), 0.0);
+            stats = richardson(exec, A, B, solution, tau, epsilon, 1000000);
+        }, 1));
+        std::cout << "  B * x = " << product << ", iterations: " << stats.iterations << ", error: " << stats.error
+                  << ", first elem: " << solution[0] << std::endl;
+    });
+    file.close();
+
+    for (const auto& k : fastest) {
+        std::cout << "Fastest for " << k.first << ": " << k.second.first << " (" << k.second.second << " s)" << std::endl;
+    }
+
+    return 0;
+}
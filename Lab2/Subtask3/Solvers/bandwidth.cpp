@@ -0,0 +1,48 @@
+#include <iostream>
+#include <vector>
+#include <fstream>
+#include <cstdlib>
+
+#include "linalg.h"
+#include "bandwidth.h"
+
+// Запуск: ./bandwidth [миллионов чисел в массиве]
+// Пропускная способность памяти (triad) по числу потоков: сначала по одному на ядро, потом с SMT-соседями.
+// Печатает точку насыщения и число потоков, которое режим SOLVERS_THREADS=auto даст ядрам,
+// и записывает его в профиль машины ($SOLVERS_PROFILE или tuning.csv).
+int main(int argc, char** argv) {
+    const size_t n = static_cast<size_t>((argc > 1) ? std::atof(argv[1]) * 1e6 : 8.4e6);
+
+    const Topology& topology = Topology::instance();
+    if (!std::getenv("PLACEMENT")) {
+        pinOpenMPThreads(topology.placement(Placement::Scatter, static_cast<int>(topology.cpus.size())));
+    }
+    const BandwidthCurve curve = measureBandwidth(topology, n);
+
+    std::ofstream file("bandwidth.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    for (size_t k = 0; k < curve.threads.size(); k++) {
+        std::cout << curve.threads[k] << " threads: " << curve.gbs[k] << " GB/s" << std::endl;
+        file << curve.threads[k] << "," << curve.gbs[k] << std::endl;
+    }
+    file.close();
+
+    std::cout << "Cores: " << curve.cores << ", saturation: " << curve.saturation << " threads, SMT "
+              << (curve.smt ? "helps" : "does not help") << ", chosen: " << curve.choose() << " threads." << std::endl;
+
+    // Запись "bandwidth" для режима SOLVERS_THREADS=auto
+    KernelConfig config;
+    config.threads = curve.choose();
+    config.smt = curve.smt;
+    TuningProfile& profile = TuningProfile::instance();
+    profile.set("bandwidth", 0, config);
+    if (!profile.save()) {
+        std::cerr << "Error: Unable to write profile " << profile.file() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <cstddef>
+#include <algorithm>
+
+#include <omp.h>
+
+#include "tuning.h"
+#include "topology.h"
+
+// Пропускная способность памяти на threads потоках, ГБ/с: triad a = b + s * c
+// на трёх массивах по n чисел (намного больше кэша), лучшее из repeats.
+inline double triadBandwidth(int threads, size_t n = size_t(1) << 23, int repeats = 5) {
+    std::vector<double> a(n), b(n), c(n);
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (size_t i = 0; i < n; i++) {
+        a[i] = 0.0;
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+    double best = 0.0;
+    for (int r = 0; r < repeats; r++) {
+        const double start = omp_get_wtime();
+        #pragma omp parallel for num_threads(threads) schedule(static)
+        for (size_t i = 0; i < n; i++) {
+            a[i] = b[i] + 3.0 * c[i];
+        }
+        const double seconds = omp_get_wtime() - start;
+        best = std::max(best, 3.0 * n * sizeof(double) / seconds / 1e9);
+    }
+    return best;
+}
+
+// Кривая пропускной способности по числу потоков. Потоки должны быть закреплены по
+// политике scatter: первые cores потоков - по одному на ядро, дальше SMT-соседи.
+struct BandwidthCurve {
+    std::vector<int> threads;
+    std::vector<double> gbs;
+    int saturation = 1;  // наименьшее число потоков (по одному на ядро) с 95% от максимума
+    bool smt = false;    // SMT-соседи добавляют больше 5%
+    int cores = 1;
+
+    // Сколько потоков давать ядрам, упирающимся в память
+    int choose() const { return smt ? threads.back() : saturation; }
+};
+
+inline BandwidthCurve measureBandwidth(const Topology& topology, size_t n = size_t(1) << 23) {
+    BandwidthCurve curve;
+    curve.cores = std::max(1, topology.cores());
+    const int cpus = std::max(1, static_cast<int>(topology.cpus.size()));
+    for (int t = 1; t < curve.cores; t *= 2) {
+        curve.threads.push_back(t);
+    }
+    curve.threads.push_back(curve.cores);
+    if (cpus > curve.cores) {
+        curve.threads.push_back(cpus);
+    }
+    for (int t : curve.threads) {
+        curve.gbs.push_back(triadBandwidth(t, n));
+    }
+
+    double peak = 0.0;
+    for (size_t k = 0; k < curve.threads.size(); k++) {
+        if (curve.threads[k] <= curve.cores) {
+            peak = std::max(peak, curve.gbs[k]);
+        }
+    }
+    for (size_t k = 0; k < curve.threads.size(); k++) {
+        if (curve.threads[k] <= curve.cores && curve.gbs[k] >= 0.95 * peak) {
+            curve.saturation = curve.threads[k];
+            break;
+        }
+    }
+    curve.smt = (cpus > curve.cores) && curve.gbs.back() > 1.05 * peak;
+    return curve;
+}
+
+/*
+Режим SOLVERS_THREADS=auto: точка насыщения памяти берётся из профиля машины (запись
+"bandwidth", её пишут ./bandwidth и ./tune). Ядра, для которых в профиле нет своей
+настройки (threadsFor в tuning.h), получают столько потоков, сколько нужно до насыщения,
+а если SMT-соседи не прибавляют пропускную способность - не больше, чем ядер.
+При запуске профиль только читается: нет записи - предупреждение и NUMBER_OF_THREADS.
+*/
+inline void selectThreadsFromEnv() {
+    const char* env = std::getenv("SOLVERS_THREADS");
+    if (!env || std::string(env) != "auto") {
+        return;
+    }
+    TuningProfile& profile = TuningProfile::instance();
+    KernelConfig config;
+    if (!profile.find("bandwidth", 0, config)) {
+        std::fprintf(stderr, "Warning: SOLVERS_THREADS=auto, but %s has no bandwidth entry for this machine; "
+                             "run ./bandwidth first.\n", profile.file().c_str());
+        return;
+    }
+    KernelConfig defaults = profile.fallback();
+    defaults.threads = config.threads;
+    defaults.smt = config.smt;
+    profile.setFallback(defaults);
+}
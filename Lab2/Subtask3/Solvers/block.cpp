@@ -0,0 +1,79 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <cmath>
+
+#include "linalg.h"
+#include "precond.h"
+#include "krylov.h"
+#include "block.h"
+
+// Запуск: ./block [N] [k] [scaled]
+// k правых частей, приходящих по очереди: B_c = B * (1 + 0.01 c sin(i)).
+// Сравнивает k отдельных решений с нуля, k решений с тёплым стартом
+// (начальное приближение - предыдущее решение) и одно блочное решение.
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const int k = (argc > 2) ? std::atoi(argv[2]) : 8;
+    const bool scaled = (argc > 3) && std::string(argv[3]) == "scaled";
+
+    DenseMatrix A(N);
+    std::vector<double> B(N);
+    if (scaled) {
+        matrixInitScaled(A);
+    } else {
+        matrixInit(A);
+    }
+    vectorInit(B);
+
+    Block Bk(N, k);
+    for (int i = 0; i < N; i++) {
+        for (int c = 0; c < k; c++) {
+            Bk(i, c) = B[i] * (1.0 + 0.01 * c * std::sin(i));
+        }
+    }
+
+    double epsilon = 0.00001;
+    int maxIter = 100000;
+
+    std::ofstream file("block.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    for (int run = 0; run < 20; run++) {
+        int coldIterations = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int c = 0; c < k; c++) {
+            std::vector<double> xprev(N, 0);
+            coldIterations += pcg(A, Bk.column(c), xprev, IdentityPreconditioner(), epsilon, maxIter).iterations;
+        }
+        std::chrono::duration<double> cold_seconds = std::chrono::steady_clock::now() - start;
+
+        int warmIterations = 0;
+        start = std::chrono::steady_clock::now();
+        std::vector<double> xprev(N, 0);
+        for (int c = 0; c < k; c++) {
+            warmIterations += pcg(A, Bk.column(c), xprev, IdentityPreconditioner(), epsilon, maxIter).iterations;
+        }
+        std::chrono::duration<double> warm_seconds = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        Block X(N, k);
+        SolveStats stats = blockCG(A, Bk, X, epsilon, maxIter);
+        std::chrono::duration<double> block_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Separate: " << coldIterations << " passes over A, " << cold_seconds.count() << " s" << std::endl;
+        std::cout << "Warm start: " << warmIterations << " passes over A, " << warm_seconds.count() << " s" << std::endl;
+        std::cout << "Block: " << stats.iterations << " passes over A, " << block_seconds.count()
+                  << " s, error: " << stats.error << std::endl;
+        file << cold_seconds.count() << "," << warm_seconds.count() << "," << block_seconds.count() << std::endl;
+    }
+
+    file.close();
+    return 0;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include "linalg.h"
+#include "sparse.h"
+#include "richardson.h"
+
+// Блок из k векторов длины n, хранится по строкам: элемент (i, c) в v[i * k + c].
+// Так при умножении каждый элемент A читается один раз и сразу работает на все k столбцов.
+struct Block {
+    int n = 0;
+    int k = 0;
+    std::vector<double> v;
+
+    Block() = default;
+    Block(int n, int k, double value = 0.0) : n(n), k(k), v(static_cast<size_t>(n) * k, value) {}
+
+    double& operator()(int i, int c) { return v[static_cast<size_t>(i) * k + c]; }
+    double operator()(int i, int c) const { return v[static_cast<size_t>(i) * k + c]; }
+
+    std::vector<double> column(int c) const {
+        std::vector<double> x(n);
+        for (int i = 0; i < n; i++) {
+            x[i] = (*this)(i, c);
+        }
+        return x;
+    }
+
+    void setColumn(int c, const std::vector<double>& x) {
+        for (int i = 0; i < n; i++) {
+            (*this)(i, c) = x[i];
+        }
+    }
+};
+
+// Y = A * X за один проход по A
+inline void matmat(const DenseMatrix& A, const Block& X, Block& Y) {
+    const int N = A.n;
+    const int k = X.k;
+    #pragma omp parallel num_threads(threadsFor("block"))
+    {
+        std::vector<double> sum(k);
+        #pragma omp for
+        for (int i = 0; i < N; i++) {
+            const double* row = A.a.data() + static_cast<size_t>(i) * N;
+            std::fill(sum.begin(), sum.end(), 0.0);
+            for (int j = 0; j < N; j++) {
+                const double a = row[j];
+                const double* x = X.v.data() + static_cast<size_t>(j) * k;
+                for (int c = 0; c < k; c++) {
+                    sum[c] += a * x[c];
+                }
+            }
+            std::copy(sum.begin(), sum.end(), Y.v.begin() + static_cast<size_t>(i) * k);
+        }
+    }
+}
+
+inline void matmat(const CSRMatrix& A, const Block& X, Block& Y) {
+    const int k = X.k;
+    const std::vector<int> bounds = rowPartition(A);
+    const int parts = static_cast<int>(bounds.size()) - 1;
+    #pragma omp parallel num_threads(parts)
+    {
+        std::vector<double> sum(k);
+        for (int t = omp_get_thread_num(); t < parts; t += omp_get_num_threads()) {
+            for (int i = bounds[t]; i < bounds[t + 1]; i++) {
+                std::fill(sum.begin(), sum.end(), 0.0);
+                for (size_t e = A.rowPtr[i]; e < A.rowPtr[i + 1]; e++) {
+                    const double a = A.val[e];
+                    const double* x = X.v.data() + static_cast<size_t>(A.col[e]) * k;
+                    for (int c = 0; c < k; c++) {
+                        sum[c] += a * x[c];
+                    }
+                }
+                std::copy(sum.begin(), sum.end(), Y.v.begin() + static_cast<size_t>(i) * k);
+            }
+        }
+    }
+}
+
+// Скалярные произведения столбцов: result[c] = sum_i X(i, c) * Y(i, c)
+inline std::vector<double> columnDots(const Block& X, const Block& Y) {
+    const int k = X.k;
+    std::vector<double> result(k, 0.0);
+    #pragma omp parallel num_threads(threadsFor("block"))
+    {
+        std::vector<double> local(k, 0.0);
+        #pragma omp for
+        for (int i = 0; i < X.n; i++) {
+            for (int c = 0; c < k; c++) {
+                local[c] += X(i, c) * Y(i, c);
+            }
+        }
+        #pragma omp critical
+        for (int c = 0; c < k; c++) {
+            result[c] += local[c];
+        }
+    }
+    return result;
+}
+
+// Сопряжённые градиенты сразу для k правых частей: у каждого столбца свои коэффициенты,
+// но умножение на A общее - один проход по матрице за итерацию на все k систем.
+// X на входе - начальное приближение (например, решения предыдущих систем).
+// Сошедшиеся столбцы замораживаются; error - худшая относительная невязка.
+template <typename Matrix>
+SolveStats blockCG(const Matrix& A, const Block& B, Block& X, double epsilon, int maxIter) {
+    const int N = A.n;
+    const int k = B.k;
+    Block R(N, k), P(N, k), Q(N, k);
+
+    matmat(A, X, Q);
+    #pragma omp parallel for num_threads(threadsFor("block"))
+    for (size_t e = 0; e < R.v.size(); e++) {
+        R.v[e] = B.v[e] - Q.v[e];
+        P.v[e] = R.v[e];
+    }
+
+    std::vector<double> normB = columnDots(B, B);
+    for (double& b : normB) {
+        b = std::sqrt(b);
+    }
+    std::vector<double> rr = columnDots(R, R);
+    std::vector<double> alpha(k), beta(k);
+    std::vector<char> active(k);
+
+    auto update = [&](SolveStats& stats) {
+        stats.error = 0.0;
+        for (int c = 0; c < k; c++) {
+            double e = (normB[c] > 0.0) ? std::sqrt(rr[c]) / normB[c] : 0.0;
+            active[c] = e > epsilon;
+            stats.error = std::max(stats.error, e);
+        }
+    };
+
+    SolveStats stats;
+    update(stats);
+    for (stats.iterations = 0; stats.iterations < maxIter && stats.error > epsilon; stats.iterations++) {
+        matmat(A, P, Q);
+        std::vector<double> pq = columnDots(P, Q);
+        for (int c = 0; c < k; c++) {
+            alpha[c] = active[c] ? rr[c] / pq[c] : 0.0;
+        }
+
+        #pragma omp parallel for num_threads(threadsFor("block"))
+        for (int i = 0; i < N; i++) {
+            for (int c = 0; c < k; c++) {
+                X(i, c) += alpha[c] * P(i, c);
+                R(i, c) -= alpha[c] * Q(i, c);
+            }
+        }
+
+        std::vector<double> rrNext = columnDots(R, R);
+        for (int c = 0; c < k; c++) {
+            beta[c] = active[c] ? rrNext[c] / rr[c] : 0.0;
+        }
+        rr = rrNext;
+
+        #pragma omp parallel for num_threads(threadsFor("block"))
+        for (int i = 0; i < N; i++) {
+            for (int c = 0; c < k; c++) {
+                P(i, c) = R(i, c) + beta[c] * P(i, c);
+            }
+        }
+        update(stats);
+    }
+    return stats;
+}
@@ -0,0 +1,113 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <stdexcept>
+
+#include "linalg.h"
+#include "spectral.h"
+#include "precond.h"
+#include "richardson.h"
+#include "krylov.h"
+#include "checkpoint.h"
+
+// Запуск: ./checkpoint [N] [chebyshev|pcg|richardson] [every] [stop]
+// 1) решение без снимков и со снимками раз в every итераций - цена снимков;
+// 2) решение обрывается на итерации stop (имитация падения) и продолжается с последнего снимка.
+// Для chebyshev и pcg матрица плохо отмасштабирована (matrixInitScaled), чтобы итераций было много;
+// richardson на ней требует порядка kappa * ln(1 / epsilon) итераций, поэтому для него - matrixInit.
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const std::string method = (argc > 2) ? argv[2] : "chebyshev";
+    const int every = (argc > 3) ? std::atoi(argv[3]) : 100;
+    const int stop = (argc > 4) ? std::atoi(argv[4]) : 1000;
+    const std::string path = method + ".ckpt";
+
+    DenseMatrix A(N);
+    std::vector<double> B(N);
+    if (method == "richardson") {
+        matrixInit(A);
+    } else {
+        matrixInitScaled(A);
+    }
+    vectorInit(B);
+
+    double epsilon = 0.00001;
+    int maxIter = 1000000;
+
+    const JacobiPreconditioner M(A);
+    const SpectralBounds bounds = estimateSpectrum(A);
+
+    auto solve = [&](std::vector<double>& x, int limit, Checkpointer* checkpoint) {
+        ConvergenceMonitor monitor(B, epsilon);
+        if (method == "chebyshev") {
+            return chebyshev(A, B, x, bounds, monitor, limit, checkpoint);
+        }
+        if (method == "richardson") {
+            return richardson(A, B, x, optimalTau(bounds), monitor, limit, checkpoint);
+        }
+        if (method == "pcg") {
+            return pcg(A, B, x, M, epsilon, limit, checkpoint);
+        }
+        throw std::invalid_argument("unknown method " + method);
+    };
+
+    std::ofstream file("checkpoint.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    try {
+        std::vector<double> xprev(N, 0);
+        auto start = std::chrono::steady_clock::now();
+        SolveStats stats = solve(xprev, maxIter, nullptr);
+        std::chrono::duration<double> plain_seconds = std::chrono::steady_clock::now() - start;
+        std::cout << "Without checkpoints: " << stats.iterations << " iterations, error " << stats.error << std::endl;
+        std::cout << "Time taken for solve: " << plain_seconds.count() << " seconds." << std::endl;
+
+        std::fill(xprev.begin(), xprev.end(), 0.0);
+        {
+            Checkpointer checkpoint(path, every);
+            checkpoint.remove();
+            start = std::chrono::steady_clock::now();
+            stats = solve(xprev, maxIter, &checkpoint);
+            checkpoint.wait();
+            std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+            std::cout << "With checkpoints: " << stats.iterations << " iterations, "
+                      << checkpoint.saved() << " snapshots" << std::endl;
+            std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+            file << method << "," << every << "," << plain_seconds.count() << ","
+                 << elapsed_seconds.count() << "," << checkpoint.saved() << std::endl;
+            checkpoint.remove();
+        }
+
+        // Падение на итерации stop: в памяти ничего не остаётся, кроме файла снимка
+        std::fill(xprev.begin(), xprev.end(), 0.0);
+        {
+            Checkpointer checkpoint(path, every);
+            stats = solve(xprev, stop, &checkpoint);
+            checkpoint.wait();
+            std::cout << "Interrupted at iteration " << stats.iterations << std::endl;
+        }
+
+        std::vector<double> resumed(N, 0);
+        Checkpointer checkpoint(path, every);
+        start = std::chrono::steady_clock::now();
+        stats = solve(resumed, maxIter, &checkpoint);
+        checkpoint.wait();
+        std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+        std::cout << "Resumed: " << stats.iterations << " iterations in total, error " << stats.error << std::endl;
+        std::cout << "Time taken for resumed solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "First elem: " << resumed[0] << std::endl;
+        checkpoint.remove();
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    file.close();
+
+    return 0;
+}
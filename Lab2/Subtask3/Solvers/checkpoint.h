@@ -0,0 +1,280 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <initializer_list>
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// Состояние итерационного решателя: номер итерации, скаляры (например, rho у Чебышёва)
+// и векторы (x всегда первым). method не даёт продолжить снимок другим методом.
+struct SolverState {
+    std::string method;
+    int iteration = 0;
+    std::vector<double> scalars;
+    std::vector<std::vector<double>> vectors;
+};
+
+// Периодические снимки состояния в двоичный файл.
+// save() только копирует векторы в один из двух буферов состояния (после первого снимка
+// без выделения памяти). Сериализацию, контрольную сумму, запись в path.tmp, fsync и
+// rename делает один долгоживущий поток-писатель, который спит на условной переменной,
+// пока нет нового снимка. Пока писатель занят одним буфером, решатель пишет в другой;
+// если писатель не успел забрать снимок, его заменяет более новый - итерация не ждёт диск,
+// а на диске всегда лежит целый снимок.
+class Checkpointer {
+public:
+    Checkpointer(std::string path, int every) : path(std::move(path)), every(every) {
+        writer = std::thread([this]() { run(); });
+    }
+    ~Checkpointer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        writer.join();
+    }
+    Checkpointer(const Checkpointer&) = delete;
+    Checkpointer& operator=(const Checkpointer&) = delete;
+
+    bool due(int iteration) const { return every > 0 && iteration > 0 && iteration % every == 0; }
+
+    // Снимок: векторы копируются в свободный буфер, остальное - в потоке-писателе
+    void save(const char* method, int iteration, std::initializer_list<double> scalars,
+              std::initializer_list<const std::vector<double>*> vectors) {
+        int slot;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            // Буфер, который писатель ещё не забрал, переписывается более новым снимком
+            slot = (writing == 0) ? 1 : ((writing == 1) ? 0 : std::max(pending, 0));
+            pending = -1;
+        }
+        SolverState& state = states[slot];
+        state.method = method;
+        state.iteration = iteration;
+        state.scalars.assign(scalars);
+        state.vectors.resize(vectors.size());
+        size_t k = 0;
+        for (const std::vector<double>* v : vectors) {
+            state.vectors[k++].assign(v->begin(), v->end());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending = slot;
+        }
+        wake.notify_all();
+    }
+
+    // Дождаться записи последнего снимка
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this]() { return pending < 0 && writing < 0; });
+        if (failed) {
+            throw std::runtime_error("Unable to write checkpoint " + path);
+        }
+    }
+
+    int saved() const { return written.load(std::memory_order_relaxed); }
+
+    // Прочитать снимок метода method для системы размера n: vectors векторов длины n и
+    // scalars скаляров. false, если файла нет; снимок другой формы - исключение.
+    bool load(const std::string& method, size_t n, SolverState& state,
+              size_t vectors = 1, size_t scalars = 0) const {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        std::string data;
+        bool ok = fstat(fd, &st) == 0;
+        if (ok) {
+            data.resize(static_cast<size_t>(st.st_size));
+            size_t done = 0;
+            while (ok && done < data.size()) {
+                ssize_t got = read(fd, &data[done], data.size() - done);
+                ok = got > 0;
+                done += ok ? static_cast<size_t>(got) : 0;
+            }
+        }
+        close(fd);
+        if (!ok || !deserialize(data, state)) {
+            throw std::runtime_error(path + ": corrupted checkpoint");
+        }
+        if (state.method != method) {
+            throw std::runtime_error(path + ": checkpoint belongs to another solve (" + state.method + ")");
+        }
+        if (state.vectors.size() != vectors || state.scalars.size() != scalars) {
+            throw std::runtime_error(path + ": checkpoint has " + std::to_string(state.vectors.size()) +
+                                     " vectors and " + std::to_string(state.scalars.size()) + " scalars, expected " +
+                                     std::to_string(vectors) + " and " + std::to_string(scalars));
+        }
+        for (const std::vector<double>& v : state.vectors) {
+            if (v.size() != n) {
+                throw std::runtime_error(path + ": checkpoint is for size " + std::to_string(v.size()) +
+                                         ", system size is " + std::to_string(n));
+            }
+        }
+        return true;
+    }
+
+    void remove() const {
+        unlink(path.c_str());
+    }
+
+private:
+    static constexpr char magic[8] = {'S', 'L', 'V', 'C', 'K', 'P', 'T', '1'};
+
+    // FNV-1a
+    static uint64_t checksum(const char* p, size_t size) {
+        uint64_t h = 1469598103934665603ull;
+        for (size_t i = 0; i < size; i++) {
+            h = (h ^ static_cast<unsigned char>(p[i])) * 1099511628211ull;
+        }
+        return h;
+    }
+
+    template <typename T>
+    static void put(std::string& out, const T& value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    static void putArray(std::string& out, const std::vector<double>& v) {
+        put<uint64_t>(out, v.size());
+        out.append(reinterpret_cast<const char*>(v.data()), v.size() * sizeof(double));
+    }
+
+    // magic | method | iteration | scalars | vectors | checksum
+    static void serialize(const SolverState& state, std::string& out) {
+        out.append(magic, sizeof(magic));
+        put<uint64_t>(out, state.method.size());
+        out.append(state.method);
+        put<int64_t>(out, state.iteration);
+        putArray(out, state.scalars);
+        put<uint64_t>(out, state.vectors.size());
+        for (const std::vector<double>& v : state.vectors) {
+            putArray(out, v);
+        }
+        put<uint64_t>(out, checksum(out.data(), out.size()));
+    }
+
+    static bool deserialize(const std::string& in, SolverState& state) {
+        if (in.size() < sizeof(magic) + sizeof(uint64_t) || std::memcmp(in.data(), magic, sizeof(magic)) != 0) {
+            return false;
+        }
+        const size_t payload = in.size() - sizeof(uint64_t);
+        uint64_t sum;
+        std::memcpy(&sum, in.data() + payload, sizeof(sum));
+        if (sum != checksum(in.data(), payload)) {
+            return false;
+        }
+
+        size_t pos = sizeof(magic);
+        auto get = [&](auto& value) {
+            if (pos + sizeof(value) > payload) {
+                return false;
+            }
+            std::memcpy(&value, in.data() + pos, sizeof(value));
+            pos += sizeof(value);
+            return true;
+        };
+        auto getArray = [&](std::vector<double>& v) {
+            uint64_t size;
+            if (!get(size) || size > (payload - pos) / sizeof(double)) {
+                return false;
+            }
+            v.resize(size);
+            std::memcpy(v.data(), in.data() + pos, size * sizeof(double));
+            pos += size * sizeof(double);
+            return true;
+        };
+
+        uint64_t length, count;
+        int64_t iteration;
+        if (!get(length) || length > payload - pos) {
+            return false;
+        }
+        state.method.assign(in.data() + pos, length);
+        pos += length;
+        if (!get(iteration) || !getArray(state.scalars) || !get(count) || count > payload / sizeof(uint64_t)) {
+            return false;
+        }
+        state.iteration = static_cast<int>(iteration);
+        state.vectors.resize(count);
+        for (std::vector<double>& v : state.vectors) {
+            if (!getArray(v)) {
+                return false;
+            }
+        }
+        return pos == payload;
+    }
+
+    bool write(const std::string& data) const {
+        const std::string tmp = path + ".tmp";
+        int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        size_t done = 0;
+        bool ok = true;
+        while (ok && done < data.size()) {
+            ssize_t wrote = ::write(fd, data.data() + done, data.size() - done);
+            ok = wrote > 0;
+            done += ok ? static_cast<size_t>(wrote) : 0;
+        }
+        ok = ok && fsync(fd) == 0;
+        ok = (close(fd) == 0) && ok;
+        return ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+    }
+
+    // Поток-писатель: забирает готовый буфер и пишет его, пока решатель заполняет другой
+    void run() {
+        std::string buffer;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            wake.wait(lock, [this]() { return pending >= 0 || stopping; });
+            if (pending < 0) {
+                return;
+            }
+            const int slot = pending;
+            writing = slot;
+            pending = -1;
+            lock.unlock();
+
+            buffer.clear();
+            serialize(states[slot], buffer);
+            const bool ok = write(buffer);
+
+            lock.lock();
+            failed = failed || !ok;
+            written.fetch_add(1, std::memory_order_relaxed);
+            writing = -1;
+            idle.notify_all();
+        }
+    }
+
+    std::string path;
+    int every;
+    SolverState states[2];
+    int pending = -1;   // буфер с новым снимком, который писатель ещё не забрал
+    int writing = -1;   // буфер, который пишется сейчас
+    bool stopping = false;
+    bool failed = false;
+    std::mutex mutex;
+    std::condition_variable wake, idle;
+    std::atomic<int> written{0};
+    std::thread writer;
+};
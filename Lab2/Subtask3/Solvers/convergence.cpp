@@ -0,0 +1,68 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+
+#include "linalg.h"
+#include "spectral.h"
+#include "richardson.h"
+#include "convergence.h"
+
+// Запуск: ./convergence [N] [checkEvery] [lagged]
+// Метод простой итерации с проверкой невязки на каждой итерации и раз в checkEvery итераций.
+// Перед полным решением делается пробный запуск на probe итераций, по нему монитор
+// оценивает, сколько итераций осталось.
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const int checkEvery = (argc > 2) ? std::atoi(argv[2]) : 10;
+    const bool lagged = (argc > 3) && std::string(argv[3]) == "lagged";
+
+    DenseMatrix A(N);
+    std::vector<double> B(N);
+    matrixInit(A);
+    vectorInit(B);
+
+    double epsilon = 0.00001;
+    int maxIter = 1000000;
+    int probe = 10;
+
+    const double tau = optimalTau(estimateSpectrum(A));
+
+    std::ofstream file("convergence.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    file << "Check Every,Lagged,Iterations,Checks,Time (s)" << std::endl;
+
+    for (int i = 0; i < 20; i++) {
+        for (int every : {1, checkEvery}) {
+            std::vector<double> xprev(N, 0);
+
+            ConvergenceMonitor probeMonitor(B, epsilon, 1);
+            SolveStats stats = richardson(A, B, xprev, tau, probeMonitor, probe);
+            std::cout << "After " << stats.iterations << " iterations: error " << probeMonitor.error()
+                      << ", rate " << probeMonitor.rate()
+                      << ", estimated remaining " << probeMonitor.remaining() << std::endl;
+
+            std::fill(xprev.begin(), xprev.end(), 0.0);
+            ConvergenceMonitor monitor(B, epsilon, every, lagged);
+            const auto start = std::chrono::steady_clock::now();
+            stats = richardson(A, B, xprev, tau, monitor, maxIter);
+            const std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+
+            std::cout << "Check every " << every << (lagged ? " (lagged)" : "") << ": "
+                      << stats.iterations << " iterations, " << monitor.checks() << " checks, error "
+                      << stats.error << std::endl;
+            std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+            std::cout << "First elem: " << xprev[0] << std::endl;
+            file << every << "," << lagged << "," << stats.iterations << "," << monitor.checks() << ","
+                 << elapsed_seconds.count() << std::endl;
+        }
+    }
+    file.close();
+
+    return 0;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+
+#include "linalg.h"
+
+// Контроль сходимости. ||B|| считается один раз при создании. Невязка нужна не на каждой
+// итерации: проверка раз в checkEvery итераций, а по наблюдаемой скорости сходимости
+// монитор оценивает, сколько итераций осталось, и ставит следующую проверку не позже
+// предсказанного момента сходимости, чтобы не перескакивать лишние итерации.
+// lagged - норму невязки r_k решатель считает в том же проходе, что и следующее
+// обновление x, без отдельной редукции; решение о выходе запаздывает на одну итерацию.
+class ConvergenceMonitor {
+public:
+    ConvergenceMonitor(const std::vector<double>& B, double epsilon, int checkEvery = 1, bool lagged = false)
+        : normB(norm(B)), epsilon(epsilon), every(std::max(checkEvery, 1)), lag(lagged) {}
+
+    // Нужна ли норма невязки на итерации k
+    bool due(int k) const { return k >= next; }
+    bool lagged() const { return lag; }
+
+    // rr = ||r_k||^2. Возвращает true, если точность достигнута.
+    bool report(int k, double rr) {
+        const double e = std::sqrt(rr) / normB;
+        if (count > 0 && k > lastIteration && e < lastError && lastError > 0.0) {
+            contraction = std::pow(e / lastError, 1.0 / (k - lastIteration));
+        }
+        lastIteration = k;
+        lastError = e;
+        count++;
+
+        const int left = remaining();
+        next = k + ((left > 0) ? std::min(left, every) : every);
+        return e <= epsilon;
+    }
+
+    // До первой проверки ошибка неизвестна: +inf
+    double error() const { return lastError; }
+    int checks() const { return count; }
+
+    // Последняя проверка была не на итерации k: error() относится к старому x
+    bool stale(int k) const { return count == 0 || lastIteration != k; }
+
+    // Средний коэффициент уменьшения невязки за итерацию между двумя последними проверками
+    double rate() const { return contraction; }
+
+    // Оценка числа итераций до сходимости после последней проверки (-1, если оценки нет)
+    int remaining() const {
+        if (lastError <= epsilon) {
+            return 0;
+        }
+        if (contraction <= 0.0 || contraction >= 1.0) {
+            return -1;
+        }
+        return static_cast<int>(std::ceil(std::log(epsilon / lastError) / std::log(contraction)));
+    }
+
+private:
+    double normB;
+    double epsilon;
+    int every;
+    bool lag;
+
+    int next = 0;
+    int count = 0;
+    int lastIteration = 0;
+    double lastError = std::numeric_limits<double>::infinity();
+    double contraction = 0.0;
+};
+
+// Итоговая ошибка решения за k итераций. Если цикл остановился по maxIter между
+// проверками (или до первой), невязка для текущего x считается заново.
+template <typename Matrix>
+double finalError(ConvergenceMonitor& monitor, int k, const Matrix& A, const std::vector<double>& B,
+                  const std::vector<double>& x, std::vector<double>& r) {
+    if (monitor.stale(k)) {
+        monitor.report(k, residualNorm2(A, B, x, r));
+    }
+    return monitor.error();
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+#include "linalg.h"
+#include "richardson.h"
+#include "backend.h"
+
+// Ядра, написанные один раз для любого бэкенда (backend.h): первый аргумент - exec
+
+// y = A * x
+template <typename Exec, typename Matrix>
+void matvec(Exec& exec, const Matrix& A, const std::vector<double>& x, std::vector<double>& y) {
+    exec.parallel_for(0, A.n, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            y[i] = rowDot(A, static_cast<int>(i), x);
+        }
+    });
+}
+
+template <typename Exec>
+double dot(Exec& exec, const std::vector<double>& a, const std::vector<double>& b) {
+    return exec.reduce(0, a.size(), [&](size_t first, size_t last) {
+        double sum = 0.0;
+        for (size_t i = first; i < last; i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    });
+}
+
+// y += alpha * x
+template <typename Exec>
+void axpy(Exec& exec, double alpha, const std::vector<double>& x, std::vector<double>& y) {
+    exec.parallel_for(0, x.size(), [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            y[i] += alpha * x[i];
+        }
+    });
+}
+
+// r = B - A * x и ||r||^2 за один проход по строкам
+template <typename Exec, typename Matrix>
+double residualNorm2(Exec& exec, const Matrix& A, const std::vector<double>& B, const std::vector<double>& x,
+                     std::vector<double>& r) {
+    return exec.reduce(0, A.n, [&](size_t first, size_t last) {
+        double rr = 0.0;
+        for (size_t i = first; i < last; i++) {
+            r[i] = B[i] - rowDot(A, static_cast<int>(i), x);
+            rr += r[i] * r[i];
+        }
+        return rr;
+    });
+}
+
+// Метод простой итерации x = x + tau * (B - Ax) на ядрах выше
+template <typename Exec, typename Matrix>
+SolveStats richardson(Exec& exec, const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                      double tau, double epsilon, int maxIter) {
+    std::vector<double> r(A.n);
+    const double normB = std::sqrt(dot(exec, B, B));
+    SolveStats stats;
+    for (; stats.iterations < maxIter; stats.iterations++) {
+        stats.error = std::sqrt(residualNorm2(exec, A, B, x, r)) / normB;
+        if (stats.error <= epsilon) {
+            break;
+        }
+        axpy(exec, tau, r, x);
+    }
+    if (stats.iterations == maxIter) {
+        stats.error = std::sqrt(residualNorm2(exec, A, B, x, r)) / normB;
+    }
+    return stats;
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "linalg.h"
+#include "precond.h"
+#include "richardson.h"
+#include "checkpoint.h"
+#include "block.h"
+
+// Метод сопряжённых градиентов с предобуславливателем (для СПД A и M).
+// checkpoint - периодические снимки x, r, p и (r, z); если снимок уже есть, решение продолжается с него.
+template <typename Matrix>
+SolveStats pcg(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+               const Preconditioner& M, double epsilon, int maxIter, Checkpointer* checkpoint = nullptr) {
+    const int N = A.n;
+    std::vector<double> r(N), z(N), p(N), Ap(N);
+    const double normB = norm(B);
+
+    SolveStats stats;
+    SolverState state;
+    double rz;
+    if (checkpoint && checkpoint->load("pcg", x.size(), state, 3, 1)) {
+        x = state.vectors[0];
+        r = state.vectors[1];
+        p = state.vectors[2];
+        rz = state.scalars.at(0);
+        stats.iterations = state.iteration;
+    } else {
+        residual(A, B, x, r);
+        M.apply(r, z);
+        p = z;
+        rz = dot(r, z);
+    }
+
+    stats.error = norm(r) / normB;
+    for (; stats.iterations < maxIter && stats.error > epsilon; stats.iterations++) {
+        if (checkpoint && checkpoint->due(stats.iterations)) {
+            checkpoint->save("pcg", stats.iterations, {rz}, {&x, &r, &p});
+        }
+        matvec(A, p, Ap);
+        double alpha = rz / dot(p, Ap);
+
+        double rr = 0.0;
+        #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:rr)
+        for (int i = 0; i < N; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+            rr += r[i] * r[i];
+        }
+        stats.error = std::sqrt(rr) / normB;
+
+        M.apply(r, z);
+        double rzNext = dot(r, z);
+        double beta = rzNext / rz;
+        rz = rzNext;
+
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            p[i] = z[i] + beta * p[i];
+        }
+    }
+    return stats;
+}
+
+// h[c] = (V_c, w) для первых cols столбцов базиса за один проход по строкам V.
+// Базис хранится по строкам (Block), поэтому внутренний цикл по столбцам векторизуется,
+// а на все cols скалярных произведений - одна редукция вместо cols.
+inline void project(const Block& V, int cols, const std::vector<double>& w, std::vector<double>& h) {
+    std::fill(h.begin(), h.begin() + cols, 0.0);
+    #pragma omp parallel num_threads(threadsFor("vector"))
+    {
+        std::vector<double> local(cols, 0.0);
+        #pragma omp for
+        for (int i = 0; i < V.n; i++) {
+            const double* row = V.v.data() + static_cast<size_t>(i) * V.k;
+            const double wi = w[i];
+            #pragma omp simd
+            for (int c = 0; c < cols; c++) {
+                local[c] += row[c] * wi;
+            }
+        }
+        #pragma omp critical
+        for (int c = 0; c < cols; c++) {
+            h[c] += local[c];
+        }
+    }
+}
+
+// w -= V h по первым cols столбцам, возвращает ||w||^2 после вычитания
+inline double subtractProjection(const Block& V, int cols, const std::vector<double>& h, std::vector<double>& w) {
+    double ww = 0.0;
+    #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:ww)
+    for (int i = 0; i < V.n; i++) {
+        const double* row = V.v.data() + static_cast<size_t>(i) * V.k;
+        double sum = 0.0;
+        #pragma omp simd reduction(+:sum)
+        for (int c = 0; c < cols; c++) {
+            sum += row[c] * h[c];
+        }
+        w[i] -= sum;
+        ww += w[i] * w[i];
+    }
+    return ww;
+}
+
+// GMRES(m) с правым предобуславливанием: минимизирует настоящую невязку B - Ax,
+// подходит для несимметричных A и любого M. Ортогонализация - классический Грам-Шмидт
+// с повтором (CGS2) блоком по всему базису: два прохода project + subtractProjection
+// вместо j последовательных скалярных произведений модифицированного Грама-Шмидта.
+// iterations - число умножений на A.
+template <typename Matrix>
+SolveStats gmres(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                 const Preconditioner& M, int m, double epsilon, int maxIter) {
+    const int N = A.n;
+    m = std::max(1, std::min(m, N));
+    Block V(N, m + 1);
+    std::vector<double> r(N), w(N), z(N);
+    std::vector<double> H(static_cast<size_t>(m + 1) * m);  // H(i, j) в H[j * (m + 1) + i]
+    std::vector<double> cs(m), sn(m), g(m + 1), h(m + 1), h2(m + 1), y(m);
+    const double normB = norm(B);
+
+    SolveStats stats;
+    double beta = std::sqrt(residualNorm2(A, B, x, r));
+    stats.error = beta / normB;
+    while (stats.iterations < maxIter && stats.error > epsilon && beta > 0.0) {
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            V(i, 0) = r[i] / beta;
+        }
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+
+        int k = 0;
+        while (k < m && stats.iterations < maxIter) {
+            #pragma omp parallel for num_threads(threadsFor("vector"))
+            for (int i = 0; i < N; i++) {
+                w[i] = V(i, k);
+            }
+            M.apply(w, z);
+            matvec(A, z, w);
+            stats.iterations++;
+
+            project(V, k + 1, w, h);
+            subtractProjection(V, k + 1, h, w);
+            project(V, k + 1, w, h2);
+            const double hnext = std::sqrt(subtractProjection(V, k + 1, h2, w));
+            for (int c = 0; c <= k; c++) {
+                h[c] += h2[c];
+            }
+            h[k + 1] = hnext;
+
+            // Поворот Гивенса сводит H к треугольной, |g[k + 1]| - норма невязки
+            for (int c = 0; c < k; c++) {
+                double t = cs[c] * h[c] + sn[c] * h[c + 1];
+                h[c + 1] = -sn[c] * h[c] + cs[c] * h[c + 1];
+                h[c] = t;
+            }
+            double rho = std::hypot(h[k], h[k + 1]);
+            cs[k] = h[k] / rho;
+            sn[k] = h[k + 1] / rho;
+            h[k] = rho;
+            h[k + 1] = 0.0;
+            g[k + 1] = -sn[k] * g[k];
+            g[k] = cs[k] * g[k];
+            std::copy(h.begin(), h.begin() + k + 1, H.begin() + static_cast<size_t>(k) * (m + 1));
+            k++;
+
+            stats.error = std::fabs(g[k]) / normB;
+            if (stats.error <= epsilon || hnext == 0.0) {
+                break;
+            }
+            #pragma omp parallel for num_threads(threadsFor("vector"))
+            for (int i = 0; i < N; i++) {
+                V(i, k) = w[i] / hnext;
+            }
+        }
+
+        // H y = g, x += M^{-1} V y
+        for (int i = k - 1; i >= 0; i--) {
+            double sum = g[i];
+            for (int j = i + 1; j < k; j++) {
+                sum -= H[static_cast<size_t>(j) * (m + 1) + i] * y[j];
+            }
+            y[i] = sum / H[static_cast<size_t>(i) * (m + 1) + i];
+        }
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            double sum = 0.0;
+            #pragma omp simd reduction(+:sum)
+            for (int c = 0; c < k; c++) {
+                sum += V(i, c) * y[c];
+            }
+            w[i] = sum;
+        }
+        M.apply(w, z);
+        axpy(1.0, z, x);
+
+        beta = std::sqrt(residualNorm2(A, B, x, r));
+        stats.error = beta / normB;
+    }
+    return stats;
+}
+
+// BiCGStab с правым предобуславливанием. Два умножения на A за итерацию, память O(N),
+// в отличие от GMRES не нужен перезапуск. Скалярные произведения, которые нужны
+// одновременно, считаются в одном проходе. Бросает runtime_error при срыве (rho = 0).
+template <typename Matrix>
+SolveStats bicgstab(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                    const Preconditioner& M, double epsilon, int maxIter) {
+    const int N = A.n;
+    std::vector<double> r(N), rhat(N), p(N, 0.0), v(N, 0.0), s(N), t(N), phat(N), shat(N);
+    const double normB = norm(B);
+
+    SolveStats stats;
+    stats.error = std::sqrt(residualNorm2(A, B, x, r)) / normB;
+    rhat = r;
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+
+    for (stats.iterations = 0; stats.iterations < maxIter && stats.error > epsilon; stats.iterations++) {
+        const double rhoNext = dot(rhat, r);
+        if (rhoNext == 0.0 || omega == 0.0) {
+            throw std::runtime_error("BiCGStab breakdown");
+        }
+        const double beta = (rhoNext / rho) * (alpha / omega);
+        rho = rhoNext;
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        }
+
+        M.apply(p, phat);
+        matvec(A, phat, v);
+        alpha = rho / dot(rhat, v);
+
+        double ss = 0.0;
+        #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:ss)
+        for (int i = 0; i < N; i++) {
+            s[i] = r[i] - alpha * v[i];
+            ss += s[i] * s[i];
+        }
+        if (std::sqrt(ss) / normB <= epsilon) {
+            axpy(alpha, phat, x);
+            stats.error = std::sqrt(ss) / normB;
+            stats.iterations++;
+            break;
+        }
+
+        M.apply(s, shat);
+        matvec(A, shat, t);
+        double ts = 0.0, tt = 0.0;
+        #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:ts, tt)
+        for (int i = 0; i < N; i++) {
+            ts += t[i] * s[i];
+            tt += t[i] * t[i];
+        }
+        omega = ts / tt;
+
+        double rr = 0.0;
+        #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:rr)
+        for (int i = 0; i < N; i++) {
+            x[i] += alpha * phat[i] + omega * shat[i];
+            r[i] = s[i] - omega * t[i];
+            rr += r[i] * r[i];
+        }
+        stats.error = std::sqrt(rr) / normB;
+    }
+    return stats;
+}
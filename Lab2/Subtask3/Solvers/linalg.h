@@ -0,0 +1,165 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <stdexcept>
+
+#include <omp.h>
+
+#include "tuning.h"
+#include "topology.h"
+#include "bandwidth.h"
+
+// При запуске программы: PLACEMENT=compact|scatter|one-per-core|node-local закрепляет потоки
+// OpenMP, SOLVERS_THREADS=auto выбирает число потоков по насыщению памяти (bandwidth.h)
+inline const bool openMPThreadsPlaced = []() {
+    try {
+        pinOpenMPThreads(placementFromEnv(NUMBER_OF_THREADS));
+        selectThreadsFromEnv();
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return false;
+    }
+    return true;
+}();
+
+// Плотная матрица n x n, хранится по строкам
+template <typename T>
+struct DenseMatrixT {
+    int n = 0;
+    std::vector<T> a;
+
+    DenseMatrixT() = default;
+    explicit DenseMatrixT(int n) : n(n), a(static_cast<size_t>(n) * n) {}
+
+    T at(int i, int j) const { return a[static_cast<size_t>(i) * n + j]; }
+};
+
+using DenseMatrix = DenseMatrixT<double>;
+
+// Матрица из задания: 2.0 на диагонали, 1.0 во всех остальных клетках
+inline void matrixInit(DenseMatrix& A) {
+    const int N = A.n;
+    #pragma omp parallel for num_threads(threadsFor("matvec", N))
+    for (int i = 0; i < N; i++) {
+        double* row = A.a.data() + static_cast<size_t>(i) * N;
+        for (int j = 0; j < N; j++) {
+            row[j] = (i == j) ? 2.0 : 1.0;
+        }
+    }
+}
+
+// Та же матрица, плохо отмасштабированная: S A S, S = diag(1 + i % 100).
+// Остаётся СПД, но число обусловленности растёт на четыре порядка.
+inline void matrixInitScaled(DenseMatrix& A) {
+    const int N = A.n;
+    #pragma omp parallel for num_threads(threadsFor("matvec", N))
+    for (int i = 0; i < N; i++) {
+        double* row = A.a.data() + static_cast<size_t>(i) * N;
+        for (int j = 0; j < N; j++) {
+            row[j] = ((i == j) ? 2.0 : 1.0) * (1 + i % 100) * (1 + j % 100);
+        }
+    }
+}
+
+// Несимметричный вариант: 2.0 на диагонали, 1.5 выше неё и 0.5 ниже.
+// Симметричная часть - матрица из задания, кососимметричная - 0.5 (U - L).
+inline void matrixInitNonsymmetric(DenseMatrix& A) {
+    const int N = A.n;
+    #pragma omp parallel for num_threads(threadsFor("matvec", N))
+    for (int i = 0; i < N; i++) {
+        double* row = A.a.data() + static_cast<size_t>(i) * N;
+        for (int j = 0; j < N; j++) {
+            row[j] = (i == j) ? 2.0 : ((j > i) ? 1.5 : 0.5);
+        }
+    }
+}
+
+inline void vectorInit(std::vector<double>& B) {
+    const int N = static_cast<int>(B.size());
+    for (int i = 0; i < N; i++) {
+        B[i] = N + 1;
+    }
+}
+
+// y = A * x (накопление всегда в double, в том числе для float-матрицы).
+// Расписание и число потоков - из профиля машины (tuning.h, ядро "matvec").
+template <typename T>
+void matvec(const DenseMatrixT<T>& A, const std::vector<T>& x, std::vector<T>& y) {
+    const int N = A.n;
+    const KernelConfig config = tuned("matvec", N);
+    config.apply();
+    #pragma omp parallel for num_threads(config.threads) schedule(runtime)
+    for (int i = 0; i < N; i++) {
+        const T* row = A.a.data() + static_cast<size_t>(i) * N;
+        double sum = 0.0;
+        for (int j = 0; j < N; j++) {
+            sum += row[j] * x[j];
+        }
+        y[i] = static_cast<T>(sum);
+    }
+}
+
+// Сумма по строке: sum_j a_ij x_j
+template <typename T, typename Vec>
+double rowDot(const DenseMatrixT<T>& A, int i, const Vec& x) {
+    const T* row = A.a.data() + static_cast<size_t>(i) * A.n;
+    double sum = 0.0;
+    for (int j = 0; j < A.n; j++) {
+        sum += row[j] * x[j];
+    }
+    return sum;
+}
+
+template <typename Vec>
+double dot(const Vec& a, const Vec& b) {
+    const int n = static_cast<int>(a.size());
+    double sum = 0.0;
+    #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:sum)
+    for (int i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <typename Vec>
+double norm(const Vec& a) {
+    return std::sqrt(dot(a, a));
+}
+
+// y += alpha * x
+template <typename Vec>
+void axpy(double alpha, const Vec& x, Vec& y) {
+    const int n = static_cast<int>(x.size());
+    #pragma omp parallel for num_threads(threadsFor("vector"))
+    for (int i = 0; i < n; i++) {
+        y[i] += alpha * x[i];
+    }
+}
+
+// r = B - A * x
+template <typename Matrix>
+void residual(const Matrix& A, const std::vector<double>& B, const std::vector<double>& x, std::vector<double>& r) {
+    matvec(A, x, r);
+    const int n = static_cast<int>(r.size());
+    #pragma omp parallel for num_threads(threadsFor("vector"))
+    for (int i = 0; i < n; i++) {
+        r[i] = B[i] - r[i];
+    }
+}
+
+// r = B - A * x и ||r||^2 в том же проходе по векторам
+template <typename Matrix>
+double residualNorm2(const Matrix& A, const std::vector<double>& B, const std::vector<double>& x, std::vector<double>& r) {
+    matvec(A, x, r);
+    const int n = static_cast<int>(r.size());
+    double rr = 0.0;
+    #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:rr)
+    for (int i = 0; i < n; i++) {
+        r[i] = B[i] - r[i];
+        rr += r[i] * r[i];
+    }
+    return rr;
+}
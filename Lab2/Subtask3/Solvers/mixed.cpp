@@ -0,0 +1,66 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+
+#include "linalg.h"
+#include "precond.h"
+#include "krylov.h"
+#include "mixed.h"
+
+// Запуск: ./mixed [N] [double|mixed] [scaled]
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const std::string mode = (argc > 2) ? argv[2] : "mixed";
+    const bool scaled = (argc > 3) && std::string(argv[3]) == "scaled";
+
+    DenseMatrix A(N);
+    std::vector<double> B(N);
+    if (scaled) {
+        matrixInitScaled(A);
+    } else {
+        matrixInit(A);
+    }
+    vectorInit(B);
+
+    DenseMatrixT<float> Af;
+    if (mode == "mixed") {
+        Af = toFloat(A);
+    }
+
+    double epsilon = 0.00001;
+    int maxIter = 1000000;
+
+    for (int i = 0; i < 20; i++) {
+        std::vector<double> xprev(N, 0);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if (mode == "mixed") {
+            RefinementStats stats = refinement(A, Af, B, xprev, epsilon);
+            std::cout << "Outer: " << stats.outer << ", inner: " << stats.inner
+                      << ", error: " << stats.error << std::endl;
+        } else {
+            SolveStats stats = pcg(A, B, xprev, IdentityPreconditioner(), epsilon, maxIter);
+            std::cout << "Iterations: " << stats.iterations << ", error: " << stats.error << std::endl;
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> elapsed_seconds = end - start;
+
+        std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "First elem: " << xprev[0] << std::endl;
+
+        std::ofstream file(mode + ".csv", std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file for writing." << std::endl;
+            return 1;
+        }
+        file << elapsed_seconds.count() << std::endl;
+        file.close();
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "linalg.h"
+#include "richardson.h"
+
+// Копия матрицы в одинарной точности: вдвое меньше байт на каждый проход по A
+inline DenseMatrixT<float> toFloat(const DenseMatrix& A) {
+    DenseMatrixT<float> Af(A.n);
+    const long long size = static_cast<long long>(A.a.size());
+    #pragma omp parallel for num_threads(threadsFor("matvec", A.n))
+    for (long long k = 0; k < size; k++) {
+        Af.a[k] = static_cast<float>(A.a[k]);
+    }
+    return Af;
+}
+
+// Метод сопряжённых градиентов целиком во float (скалярные произведения копятся в double).
+// Используется как внутренний решатель, поэтому точность epsilon здесь грубая.
+inline SolveStats cgFloat(const DenseMatrixT<float>& A, const std::vector<float>& b, std::vector<float>& x,
+                          double epsilon, int maxIter) {
+    const int N = A.n;
+    std::vector<float> r(b), p(b), Ap(N);
+    std::fill(x.begin(), x.end(), 0.0f);
+    const double normB = norm(b);
+
+    double rr = dot(r, r);
+    SolveStats stats;
+    stats.error = std::sqrt(rr) / normB;
+    for (stats.iterations = 0; stats.iterations < maxIter && stats.error > epsilon; stats.iterations++) {
+        matvec(A, p, Ap);
+        const float alpha = static_cast<float>(rr / dot(p, Ap));
+
+        double rrNext = 0.0;
+        #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:rrNext)
+        for (int i = 0; i < N; i++) {
+            x[i] += alpha * p[i];
+            r[i] -= alpha * Ap[i];
+            rrNext += static_cast<double>(r[i]) * r[i];
+        }
+        const float beta = static_cast<float>(rrNext / rr);
+        rr = rrNext;
+        stats.error = std::sqrt(rr) / normB;
+
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            p[i] = r[i] + beta * p[i];
+        }
+    }
+    return stats;
+}
+
+struct RefinementStats {
+    int outer = 0;         // уточнений (проходов по double-матрице)
+    int inner = 0;         // итераций внутреннего решателя во float суммарно
+    double error = 0.0;    // ||B - Ax|| / ||B|| в double
+};
+
+// Итерационное уточнение: невязка и поправка к решению в double,
+// уравнение на поправку A d = r решается во float с точностью innerEpsilon.
+inline RefinementStats refinement(const DenseMatrix& A, const DenseMatrixT<float>& Af,
+                                  const std::vector<double>& B, std::vector<double>& x,
+                                  double epsilon, double innerEpsilon = 1e-3,
+                                  int maxOuter = 50, int maxInner = 1000) {
+    const int N = A.n;
+    std::vector<double> r(N);
+    std::vector<float> rf(N), df(N);
+    const double normB = norm(B);
+
+    // Невязка считается в конце каждого прохода, поэтому stats.error
+    // всегда относится к возвращаемому x, даже если maxOuter исчерпан
+    RefinementStats stats;
+    residual(A, B, x, r);
+    stats.error = norm(r) / normB;
+    for (stats.outer = 0; stats.outer < maxOuter && stats.error > epsilon; stats.outer++) {
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            rf[i] = static_cast<float>(r[i]);
+        }
+        stats.inner += cgFloat(Af, rf, df, innerEpsilon, maxInner).iterations;
+
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            x[i] += df[i];
+        }
+
+        residual(A, B, x, r);
+        stats.error = norm(r) / normB;
+    }
+    return stats;
+}
@@ -0,0 +1,267 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <cstring>
+#include <cctype>
+#include <cstddef>
+#include <charconv>
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <limits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "linalg.h"
+#include "sparse.h"
+
+// Чтение файла целиком: каждый поток читает свой кусок через pread
+inline std::string readFileParallel(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Unable to stat " + path);
+    }
+    const size_t size = static_cast<size_t>(st.st_size);
+    std::string data(size, '\0');
+
+    bool failed = false;
+    #pragma omp parallel num_threads(NUMBER_OF_THREADS) reduction(||:failed)
+    {
+        const size_t threads = omp_get_num_threads();
+        const size_t t = omp_get_thread_num();
+        size_t first = size * t / threads;
+        size_t last = size * (t + 1) / threads;
+        while (first < last) {
+            ssize_t got = pread(fd, &data[first], last - first, static_cast<off_t>(first));
+            if (got <= 0) {
+                failed = true;
+                break;
+            }
+            first += static_cast<size_t>(got);
+        }
+    }
+    close(fd);
+    if (failed) {
+        throw std::runtime_error("Unable to read " + path);
+    }
+    return data;
+}
+
+struct MatrixMarketTimings {
+    double read = 0.0;     // чтение файла (pread)
+    double parse = 0.0;    // разбор текста в тройки (i, j, a)
+    double convert = 0.0;  // тройки -> CSR
+};
+
+// Matrix Market (coordinate, real/integer/pattern, general/symmetric/skew-symmetric) -> CSR.
+// Тело файла режется на куски по границам строк, каждый поток разбирает свой кусок
+// через std::from_chars в локальные массивы; потом тройки собираются в CSR
+// параллельным подсчётом по строкам.
+inline CSRMatrix readMatrixMarket(const std::string& path, MatrixMarketTimings* timings = nullptr) {
+    const double start = omp_get_wtime();
+    const std::string data = readFileParallel(path);
+    const double loaded = omp_get_wtime();
+    const char* text = data.data();
+    const size_t size = data.size();
+
+    // Заголовок
+    size_t pos = data.find('\n');
+    if (data.compare(0, 14, "%%MatrixMarket") != 0 || pos == std::string::npos) {
+        throw std::runtime_error(path + ": not a Matrix Market file");
+    }
+    // %%MatrixMarket matrix <формат> <тип> <симметрия>, поля сравниваются целиком:
+    // подстрока "symmetric" есть и в "skew-symmetric"
+    std::string banner = data.substr(0, pos);
+    std::transform(banner.begin(), banner.end(), banner.begin(), ::tolower);
+    std::istringstream fields(banner);
+    std::string magic, object, format, field, symmetry;
+    fields >> magic >> object >> format >> field >> symmetry;
+    if (object != "matrix" || format != "coordinate") {
+        throw std::runtime_error(path + ": only coordinate matrices are supported");
+    }
+    if (field != "real" && field != "integer" && field != "pattern") {
+        throw std::runtime_error(path + ": unsupported field '" + field + "'");
+    }
+    if (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric") {
+        throw std::runtime_error(path + ": unsupported symmetry '" + symmetry + "'");
+    }
+    const bool pattern = field == "pattern";
+    const bool mirrored = symmetry != "general";
+    // Симметричная часть хранит a_ji = a_ij, кососимметричная a_ji = -a_ij
+    const double mirrorSign = (symmetry == "skew-symmetric") ? -1.0 : 1.0;
+
+    // Комментарии и строка размеров
+    pos++;
+    while (pos < size && text[pos] == '%') {
+        pos = data.find('\n', pos);
+        pos = (pos == std::string::npos) ? size : pos + 1;
+    }
+    long long rows = 0, cols = 0, entries = 0;
+    {
+        const char* p = text + pos;
+        const char* end = text + size;
+        auto skip = [&]() { while (p < end && (*p == ' ' || *p == '\t')) p++; };
+        auto number = [&](long long& value) {
+            skip();
+            auto result = std::from_chars(p, end, value);
+            p = result.ptr;
+            return result.ec == std::errc();
+        };
+        if (!number(rows) || !number(cols) || !number(entries)) {
+            throw std::runtime_error(path + ": malformed size line");
+        }
+        pos = data.find('\n', pos);
+        pos = (pos == std::string::npos) ? size : pos + 1;
+    }
+    if (rows <= 0 || rows != cols) {
+        throw std::runtime_error(path + ": matrix must be square");
+    }
+    if (rows > std::numeric_limits<int>::max() || entries < 0) {
+        throw std::runtime_error(path + ": matrix size out of range");
+    }
+
+    // Параллельный разбор тела
+    const int threads = NUMBER_OF_THREADS;
+    std::vector<std::vector<int>> localRow(threads), localCol(threads);
+    std::vector<std::vector<double>> localVal(threads);
+    std::vector<long long> localEntries(threads, 0);  // тройки в файле, без зеркальных
+    bool malformed = false;
+
+    #pragma omp parallel num_threads(threads) reduction(||:malformed)
+    for (int t = omp_get_thread_num(); t < threads; t += omp_get_num_threads()) {
+        const size_t body = size - pos;
+        size_t first = pos + body * t / threads;
+        size_t last = pos + body * (t + 1) / threads;
+        // Кусок начинается с начала строки и заканчивается концом строки
+        if (t > 0) {
+            while (first < size && text[first - 1] != '\n') first++;
+        }
+        while (last < size && text[last - 1] != '\n') last++;
+
+        std::vector<int>& R = localRow[t];
+        std::vector<int>& Cl = localCol[t];
+        std::vector<double>& V = localVal[t];
+        R.reserve((last - first) / 16);
+        Cl.reserve((last - first) / 16);
+        V.reserve((last - first) / 16);
+
+        const char* p = text + first;
+        const char* end = text + last;
+        while (p < end) {
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')) p++;
+            if (p >= end) break;
+            if (*p == '%') {
+                while (p < end && *p != '\n') p++;
+                continue;
+            }
+            int i = 0, j = 0;
+            double a = 1.0;
+            auto r1 = std::from_chars(p, end, i);
+            p = r1.ptr;
+            while (p < end && (*p == ' ' || *p == '\t')) p++;
+            auto r2 = std::from_chars(p, end, j);
+            p = r2.ptr;
+            if (r1.ec != std::errc() || r2.ec != std::errc() || i < 1 || j < 1 || i > rows || j > cols) {
+                malformed = true;
+                break;
+            }
+            if (!pattern) {
+                while (p < end && (*p == ' ' || *p == '\t')) p++;
+                auto r3 = std::from_chars(p, end, a);
+                if (r3.ec != std::errc()) {
+                    malformed = true;
+                    break;
+                }
+                p = r3.ptr;
+            }
+            while (p < end && *p != '\n') p++;
+
+            R.push_back(i - 1);
+            Cl.push_back(j - 1);
+            V.push_back(a);
+            localEntries[t]++;
+            if (mirrored && i != j) {
+                R.push_back(j - 1);
+                Cl.push_back(i - 1);
+                V.push_back(mirrorSign * a);
+            }
+        }
+    }
+    if (malformed) {
+        throw std::runtime_error(path + ": malformed entry");
+    }
+    const long long found = std::accumulate(localEntries.begin(), localEntries.end(), 0LL);
+    if (found != entries) {
+        throw std::runtime_error(path + ": truncated/extra entries (" + std::to_string(found) + " of " +
+                                 std::to_string(entries) + ")");
+    }
+
+    const double parsed = omp_get_wtime();
+
+    // Тройки -> CSR
+    const int N = static_cast<int>(rows);
+    CSRMatrix A;
+    A.n = N;
+    std::vector<size_t> counts(N + 1, 0);
+    #pragma omp parallel for num_threads(threads) schedule(static, 1)
+    for (int t = 0; t < threads; t++) {
+        for (int i : localRow[t]) {
+            #pragma omp atomic
+            counts[i + 1]++;
+        }
+    }
+    std::partial_sum(counts.begin(), counts.end(), counts.begin());
+    A.rowPtr = counts;
+    A.col.resize(A.rowPtr[N]);
+    A.val.resize(A.rowPtr[N]);
+
+    #pragma omp parallel for num_threads(threads) schedule(static, 1)
+    for (int t = 0; t < threads; t++) {
+        for (size_t k = 0; k < localRow[t].size(); k++) {
+            size_t slot;
+            #pragma omp atomic capture
+            slot = counts[localRow[t][k]]++;
+            A.col[slot] = localCol[t][k];
+            A.val[slot] = localVal[t][k];
+        }
+    }
+
+    // Столбцы внутри строки по возрастанию
+    #pragma omp parallel num_threads(threads)
+    {
+        std::vector<std::pair<int, double>> row;
+        #pragma omp for schedule(dynamic, 256)
+        for (int i = 0; i < N; i++) {
+            size_t first = A.rowPtr[i], last = A.rowPtr[i + 1];
+            if (std::is_sorted(A.col.begin() + first, A.col.begin() + last)) {
+                continue;
+            }
+            row.clear();
+            for (size_t k = first; k < last; k++) {
+                row.emplace_back(A.col[k], A.val[k]);
+            }
+            std::sort(row.begin(), row.end());
+            for (size_t k = first; k < last; k++) {
+                A.col[k] = row[k - first].first;
+                A.val[k] = row[k - first].second;
+            }
+        }
+    }
+
+    if (timings) {
+        timings->read = loaded - start;
+        timings->parse = parsed - loaded;
+        timings->convert = omp_get_wtime() - parsed;
+    }
+    return A;
+}
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <stdexcept>
+
+#include "linalg.h"
+#include "sparse.h"
+#include "mtx.h"
+#include "spectral.h"
+#include "precond.h"
+#include "richardson.h"
+#include "krylov.h"
+
+// Запуск: ./mtxsolve file.mtx [cg|pcg|richardson|chebyshev|gmres|bicgstab]
+// Правая часть B = A * (1, ..., 1), так что точное решение известно.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " file.mtx [cg|pcg|richardson|chebyshev|gmres|bicgstab]" << std::endl;
+        return 1;
+    }
+    const std::string path = argv[1];
+    const std::string method = (argc > 2) ? argv[2] : "pcg";
+
+    CSRMatrix A;
+    MatrixMarketTimings timings;
+    try {
+        A = readMatrixMarket(path, &timings);
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "N = " << A.n << ", nnz = " << A.nnz() << std::endl;
+    std::cout << "Time taken for read: " << timings.read << " seconds." << std::endl;
+    std::cout << "Time taken for parse: " << timings.parse << " seconds." << std::endl;
+    std::cout << "Time taken for convert: " << timings.convert << " seconds." << std::endl;
+
+    std::vector<double> ones(A.n, 1.0);
+    std::vector<double> B(A.n);
+    matvec(A, ones, B);
+
+    double epsilon = 0.00001;
+    int maxIter = 100000;
+    std::vector<double> xprev(A.n, 0);
+
+    const auto start = std::chrono::steady_clock::now();
+    SolveStats stats;
+    if (method == "cg") {
+        stats = pcg(A, B, xprev, IdentityPreconditioner(), epsilon, maxIter);
+    } else if (method == "pcg") {
+        stats = pcg(A, B, xprev, JacobiPreconditioner(A), epsilon, maxIter);
+    } else if (method == "richardson") {
+        stats = richardson(A, B, xprev, optimalTau(estimateSpectrum(A)), epsilon, maxIter);
+    } else if (method == "chebyshev") {
+        stats = chebyshev(A, B, xprev, estimateSpectrum(A), epsilon, maxIter);
+    } else if (method == "gmres") {
+        stats = gmres(A, B, xprev, JacobiPreconditioner(A), 30, epsilon, maxIter);
+    } else if (method == "bicgstab") {
+        try {
+            stats = bicgstab(A, B, xprev, JacobiPreconditioner(A), epsilon, maxIter);
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+    } else {
+        std::cerr << "Error: unknown method " << method << std::endl;
+        return 1;
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const std::chrono::duration<double> elapsed_seconds = end - start;
+
+    double maxError = 0.0;
+    for (int i = 0; i < A.n; i++) {
+        maxError = std::max(maxError, std::fabs(xprev[i] - 1.0));
+    }
+    std::cout << "Iterations: " << stats.iterations << ", residual: " << stats.error
+              << ", max |x - 1|: " << maxError << std::endl;
+    std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+
+    std::ofstream file("mtxsolve.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    file << path << "," << method << "," << timings.read << "," << timings.parse << "," << timings.convert << ","
+         << elapsed_seconds.count() << "," << stats.iterations << std::endl;
+    file.close();
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+
+#include "linalg.h"
+#include "stencil.h"
+#include "multigrid.h"
+
+// Запуск: ./multigrid [nx] [ny] [nz] [V|W]
+// Размеры вида 2^k - 1 дают полную иерархию сеток.
+int main(int argc, char** argv) {
+    const int nx = (argc > 1) ? std::atoi(argv[1]) : 255;
+    const int ny = (argc > 2) ? std::atoi(argv[2]) : nx;
+    const int nz = (argc > 3) ? std::atoi(argv[3]) : nx;
+    const std::string cycle = (argc > 4) ? argv[4] : "V";
+
+    Poisson A(nx, ny, nz);
+    const double h = 1.0 / (nx + 1);
+    Field f = makeField(A, h * h);
+
+    Multigrid mg(A, (cycle == "W") ? 2 : 1);
+    std::cout << "Unknowns: " << A.n << ", levels: " << mg.depth() << std::endl;
+
+    double epsilon = 0.00001;
+    int maxCycles = 100;
+
+    for (int i = 0; i < 20; i++) {
+        Field u = makeField(A);
+
+        const auto start = std::chrono::steady_clock::now();
+        SolveStats stats = mg.solve(f, u, epsilon, maxCycles);
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> elapsed_seconds = end - start;
+
+        std::cout << "Cycles: " << stats.iterations << ", error: " << stats.error << std::endl;
+        std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "Center: " << u[A.n / 2] << std::endl;
+
+        std::ofstream file("multigrid_" + cycle + ".csv", std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file for writing." << std::endl;
+            return 1;
+        }
+        file << A.n << "," << elapsed_seconds.count() << "," << stats.iterations << std::endl;
+        file.close();
+    }
+
+    return 0;
+}
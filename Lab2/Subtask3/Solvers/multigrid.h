@@ -0,0 +1,202 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <utility>
+
+#include "linalg.h"
+#include "stencil.h"
+#include "richardson.h"
+
+// Геометрический многосеточный метод для Poisson. Узловые сетки: n -> (n - 1) / 2
+// по каждому измерению, поэтому лучше всего n = 2^k - 1. Сглаживатель - красно-чёрный
+// Гаусс-Зейдель (redBlackSweep), сужение - полное взвешивание, продолжение - (би/три)линейная
+// интерполяция. Все три операции параллельны по слоям плоскостей потоков-владельцев.
+class Multigrid {
+public:
+    struct Level {
+        Poisson A;
+        Field u, f, r;
+
+        explicit Level(const Poisson& A) : A(A), u(makeField(A)), f(makeField(A)), r(makeField(A)) {}
+    };
+
+    // gamma = 1 - V-цикл, gamma = 2 - W-цикл
+    Multigrid(const Poisson& A, int gamma = 1, int preSmooth = 2, int postSmooth = 2,
+              int coarseSweeps = 50, double omega = 1.0)
+        : gamma(gamma), preSmooth(preSmooth), postSmooth(postSmooth),
+          coarseSweeps(coarseSweeps), omega(omega) {
+        levels.emplace_back(A);
+        Poisson fine = A;
+        while (coarsenable(fine)) {
+            fine = Poisson((fine.nx - 1) / 2, (fine.ny - 1) / 2, (fine.nz > 1) ? (fine.nz - 1) / 2 : 1);
+            levels.emplace_back(fine);
+        }
+    }
+
+    int depth() const { return static_cast<int>(levels.size()); }
+
+    // Циклы до относительной невязки epsilon; iterations - число циклов
+    SolveStats solve(const Field& f, Field& u, double epsilon, int maxCycles) {
+        Level& top = levels[0];
+        top.f = f;
+        top.u.swap(u);
+        const double normF = norm(f);
+
+        SolveStats stats;
+        for (stats.iterations = 0; stats.iterations < maxCycles; stats.iterations++) {
+            stats.error = residualNorm(top) / normF;
+            if (stats.error <= epsilon) {
+                break;
+            }
+            cycle(0);
+        }
+        top.u.swap(u);
+        return stats;
+    }
+
+private:
+    static bool coarsenable(const Poisson& A) {
+        bool odd = (A.nx % 2 == 1) && (A.ny % 2 == 1) && (A.nz == 1 || A.nz % 2 == 1);
+        bool big = (A.nx >= 3) && (A.ny >= 3) && (A.nz == 1 || A.nz >= 3);
+        return odd && big && (A.nx > 3 || A.ny > 3 || A.nz > 3);
+    }
+
+    // r = f - A u, возвращает ||r||
+    static double residualNorm(Level& level) {
+        matvec(level.A, level.u, level.r);
+        double rr = 0.0;
+        #pragma omp parallel for num_threads(stencilOwners(level.A)) reduction(+:rr)
+        for (int i = 0; i < level.A.n; i++) {
+            level.r[i] = level.f[i] - level.r[i];
+            rr += level.r[i] * level.r[i];
+        }
+        return std::sqrt(rr);
+    }
+
+    void cycle(int l) {
+        Level& level = levels[l];
+        if (l + 1 == depth()) {
+            for (int s = 0; s < coarseSweeps; s++) {
+                redBlackSweep(level.A, level.f, level.u, omega);
+            }
+            return;
+        }
+
+        for (int s = 0; s < preSmooth; s++) {
+            redBlackSweep(level.A, level.f, level.u, omega);
+        }
+        residualNorm(level);
+
+        Level& coarse = levels[l + 1];
+        restrictResidual(level, coarse);
+        std::fill(coarse.u.begin(), coarse.u.end(), 0.0);
+        for (int g = 0; g < gamma; g++) {
+            cycle(l + 1);
+        }
+        prolongAdd(coarse, level);
+
+        for (int s = 0; s < postSmooth; s++) {
+            redBlackSweep(level.A, level.f, level.u, omega);
+        }
+    }
+
+    // Полное взвешивание: coarse.f = 4 * R r. Множитель 4 = (2h / h)^2 переводит
+    // правую часть к масштабу грубой сетки, т.к. оператор хранится без деления на h^2.
+    static void restrictResidual(const Level& fine, Level& coarse) {
+        const Poisson& F = fine.A;
+        const Poisson& C = coarse.A;
+        const bool is3d = C.nz > 1;
+        const double scale = is3d ? 4.0 / 64.0 : 4.0 / 16.0;
+
+        #pragma omp parallel num_threads(stencilOwners(C))
+        {
+            std::pair<int, int> own = ownedPlanes(C, omp_get_thread_num(), omp_get_num_threads());
+            for (int p = own.first; p < own.second; p++) {
+                for (int row = 0; row < C.rowsPerPlane(); row++) {
+                    int J = is3d ? row : p;
+                    int K = is3d ? p : 0;
+                    for (int I = 0; I < C.nx; I++) {
+                        double sum = 0.0;
+                        for (int dz = (is3d ? -1 : 0); dz <= (is3d ? 1 : 0); dz++) {
+                            int z = is3d ? 2 * K + 1 + dz : 0;
+                            double wz = (is3d && dz == 0) ? 2.0 : 1.0;
+                            for (int dy = -1; dy <= 1; dy++) {
+                                int y = 2 * J + 1 + dy;
+                                double wy = (dy == 0) ? 2.0 : 1.0;
+                                const double* r = fine.r.data() + static_cast<size_t>(F.nx) * (y + static_cast<size_t>(F.ny) * z);
+                                int x = 2 * I + 1;
+                                sum += wz * wy * (r[x - 1] + 2.0 * r[x] + r[x + 1]);
+                            }
+                        }
+                        coarse.f[static_cast<size_t>(C.nx) * (J + static_cast<size_t>(C.ny) * K) + I] = scale * sum;
+                    }
+                }
+            }
+        }
+    }
+
+    // Индекс тонкой сетки -> соседние узлы грубой сетки с весами
+    static int coarseNeighbours(int i, int nc, int* c, double* w) {
+        if (i % 2 == 1) {
+            c[0] = (i - 1) / 2;
+            w[0] = 1.0;
+            return 1;
+        }
+        int count = 0;
+        if (i / 2 - 1 >= 0) {
+            c[count] = i / 2 - 1;
+            w[count++] = 0.5;
+        }
+        if (i / 2 < nc) {
+            c[count] = i / 2;
+            w[count++] = 0.5;
+        }
+        return count;
+    }
+
+    // fine.u += P coarse.u (линейная интерполяция по каждому измерению)
+    static void prolongAdd(const Level& coarse, Level& fine) {
+        const Poisson& F = fine.A;
+        const Poisson& C = coarse.A;
+        const bool is3d = F.nz > 1;
+
+        #pragma omp parallel num_threads(stencilOwners(F))
+        {
+            std::pair<int, int> own = ownedPlanes(F, omp_get_thread_num(), omp_get_num_threads());
+            for (int p = own.first; p < own.second; p++) {
+                for (int row = 0; row < F.rowsPerPlane(); row++) {
+                    int y = is3d ? row : p;
+                    int z = is3d ? p : 0;
+                    int cy[2], cz[2] = {0, 0};
+                    double wy[2], wz[2] = {1.0, 1.0};
+                    int ny = coarseNeighbours(y, C.ny, cy, wy);
+                    int nz = is3d ? coarseNeighbours(z, C.nz, cz, wz) : 1;
+                    double* u = fine.u.data() + static_cast<size_t>(F.nx) * (y + static_cast<size_t>(F.ny) * z);
+                    for (int x = 0; x < F.nx; x++) {
+                        int cx[2];
+                        double wx[2];
+                        int nx = coarseNeighbours(x, C.nx, cx, wx);
+                        double sum = 0.0;
+                        for (int a = 0; a < nz; a++) {
+                            for (int b = 0; b < ny; b++) {
+                                const double* uc = coarse.u.data() + static_cast<size_t>(C.nx) * (cy[b] + static_cast<size_t>(C.ny) * cz[a]);
+                                for (int c = 0; c < nx; c++) {
+                                    sum += wz[a] * wy[b] * wx[c] * uc[cx[c]];
+                                }
+                            }
+                        }
+                        u[x] += sum;
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<Level> levels;
+    int gamma;
+    int preSmooth;
+    int postSmooth;
+    int coarseSweeps;
+    double omega;
+};
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <memory>
+#include <stdexcept>
+
+#include "linalg.h"
+#include "spectral.h"
+#include "precond.h"
+#include "richardson.h"
+#include "krylov.h"
+
+// Запуск: ./nonsymmetric [N] [gmres|bicgstab|richardson] [m] [none|jacobi|ssor]
+// Несимметричная матрица matrixInitNonsymmetric, m - длина цикла GMRES(m).
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const std::string method = (argc > 2) ? argv[2] : "gmres";
+    const int m = (argc > 3) ? std::atoi(argv[3]) : 30;
+    const std::string precondName = (argc > 4) ? argv[4] : "none";
+
+    DenseMatrix A(N);
+    std::vector<double> B(N);
+    matrixInitNonsymmetric(A);
+    vectorInit(B);
+
+    double epsilon = 0.00001;
+    int maxIter = 100000;
+
+    for (int i = 0; i < 20; i++) {
+        std::vector<double> xprev(N, 0);
+
+        const auto start = std::chrono::steady_clock::now();
+        SolveStats stats;
+        try {
+            std::unique_ptr<Preconditioner> M = makePreconditioner(precondName, A);
+            if (method == "gmres") {
+                stats = gmres(A, B, xprev, *M, m, epsilon, maxIter);
+            } else if (method == "bicgstab") {
+                stats = bicgstab(A, B, xprev, *M, epsilon, maxIter);
+            } else if (method == "richardson") {
+                stats = richardson(A, B, xprev, *M, optimalTau(estimateSpectrum(A, *M)), epsilon, maxIter);
+            } else {
+                throw std::invalid_argument("unknown method " + method);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Error: " << e.what() << std::endl;
+            return 1;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> elapsed_seconds = end - start;
+
+        std::cout << "Iterations: " << stats.iterations << ", error: " << stats.error << std::endl;
+        std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "First elem: " << xprev[0] << std::endl;
+
+        std::ofstream file("nonsymmetric.csv", std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file for writing." << std::endl;
+            return 1;
+        }
+        file << method << "," << m << "," << precondName << "," << elapsed_seconds.count() << ","
+             << stats.iterations << std::endl;
+        file.close();
+    }
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <stdexcept>
+
+#include "tuning.h"
+#include "topology.h"
+
+// Запуск: ./places [потоков] [compact|scatter|one-per-core|node-local]
+// Печатает значение OMP_PLACES для размещения (по умолчанию - из PLACEMENT), чтобы задать его
+// до запуска программы: export OMP_PLACES=$(./places 20 scatter) OMP_PROC_BIND=close
+int main(int argc, char** argv) {
+    const int threads = (argc > 1) ? std::atoi(argv[1]) : NUMBER_OF_THREADS;
+    const char* env = std::getenv("PLACEMENT");
+    const std::string policy = (argc > 2) ? argv[2] : (env ? env : "scatter");
+
+    try {
+        std::cout << openMPPlaces(Topology::instance().placement(placementFromName(policy), threads)) << std::endl;
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
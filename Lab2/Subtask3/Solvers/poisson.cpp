@@ -0,0 +1,53 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+
+#include "linalg.h"
+#include "stencil.h"
+
+// Запуск: ./poisson [nx] [ny] [nz] [sweeps] [blocked|wavefront]
+// nz = 1 - двумерная задача (5-точечный шаблон), иначе трёхмерная (7-точечный).
+int main(int argc, char** argv) {
+    const int nx = (argc > 1) ? std::atoi(argv[1]) : 256;
+    const int ny = (argc > 2) ? std::atoi(argv[2]) : nx;
+    const int nz = (argc > 3) ? std::atoi(argv[3]) : nx;
+    const int sweeps = (argc > 4) ? std::atoi(argv[4]) : 8;
+    const std::string mode = (argc > 5) ? argv[5] : "wavefront";
+
+    Poisson A(nx, ny, nz);
+    // -Laplace u = 1 на единичном кубе, правая часть домножена на h^2
+    const double h = 1.0 / (nx + 1);
+    Field f = makeField(A, h * h);
+
+    std::cout << "Unknowns: " << A.n << " (dense A would take "
+              << static_cast<double>(A.n) * A.n * sizeof(double) / 1e9 << " GB)" << std::endl;
+
+    double epsilon = 0.00001;
+    int maxIter = 10000000;
+
+    for (int i = 0; i < 20; i++) {
+        Field u = makeField(A);
+
+        const auto start = std::chrono::steady_clock::now();
+        SolveStats stats = poissonJacobi(A, f, u, epsilon, maxIter, sweeps, mode == "wavefront");
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> elapsed_seconds = end - start;
+
+        std::cout << "Sweeps: " << stats.iterations << ", error: " << stats.error << std::endl;
+        std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "Center: " << u[A.n / 2] << std::endl;
+
+        std::ofstream file("poisson_" + mode + ".csv", std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file for writing." << std::endl;
+            return 1;
+        }
+        file << elapsed_seconds.count() << "," << stats.iterations << std::endl;
+        file.close();
+    }
+
+    return 0;
+}
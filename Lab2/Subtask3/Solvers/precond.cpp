@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+#include <memory>
+
+#include "linalg.h"
+#include "spectral.h"
+#include "precond.h"
+#include "richardson.h"
+#include "krylov.h"
+
+// Запуск: ./precond [N] [none|jacobi|block|ssor] [richardson|cg] [scaled]
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const std::string precondName = (argc > 2) ? argv[2] : "jacobi";
+    const std::string method = (argc > 3) ? argv[3] : "cg";
+    const bool scaled = (argc > 4) && std::string(argv[4]) == "scaled";
+
+    DenseMatrix A(N);
+    std::vector<double> B(N);
+    if (scaled) {
+        matrixInitScaled(A);
+    } else {
+        matrixInit(A);
+    }
+    vectorInit(B);
+
+    double epsilon = 0.00001;
+    int maxIter = 1000000;
+
+    for (int i = 0; i < 20; i++) {
+        std::vector<double> xprev(N, 0);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::unique_ptr<Preconditioner> M = makePreconditioner(precondName, A);
+        const auto setup = std::chrono::steady_clock::now();
+
+        SolveStats stats;
+        if (method == "cg") {
+            stats = pcg(A, B, xprev, *M, epsilon, maxIter);
+        } else {
+            SpectralBounds bounds = estimateSpectrum(A, *M);
+            std::cout << "cond(M^-1 A) = " << bounds.condition() << std::endl;
+            stats = richardson(A, B, xprev, *M, optimalTau(bounds), epsilon, maxIter);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> setup_seconds = setup - start;
+        const std::chrono::duration<double> elapsed_seconds = end - start;
+
+        std::cout << "Iterations: " << stats.iterations << ", error: " << stats.error << std::endl;
+        std::cout << "Time taken for setup: " << setup_seconds.count() << " seconds." << std::endl;
+        std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "First elem: " << xprev[0] << std::endl;
+
+        std::ofstream file(method + "_" + precondName + ".csv", std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file for writing." << std::endl;
+            return 1;
+        }
+        file << elapsed_seconds.count() << "," << stats.iterations << std::endl;
+        file.close();
+    }
+
+    return 0;
+}
@@ -0,0 +1,225 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <algorithm>
+#include <stdexcept>
+
+#include "linalg.h"
+
+// Предобуславливатель M: apply вычисляет z = M^{-1} r.
+// Все реализации симметричны и положительно определены для СПД матрицы A,
+// поэтому подходят и для метода простой итерации, и для метода сопряжённых градиентов.
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+    virtual void apply(const std::vector<double>& r, std::vector<double>& z) const = 0;
+};
+
+// Без предобуславливания: z = r
+class IdentityPreconditioner : public Preconditioner {
+public:
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override {
+        const int n = static_cast<int>(r.size());
+        #pragma omp parallel for num_threads(threadsFor("precond"))
+        for (int i = 0; i < n; i++) {
+            z[i] = r[i];
+        }
+    }
+};
+
+// Якоби: M = diag(A)
+class JacobiPreconditioner : public Preconditioner {
+public:
+    template <typename Matrix>
+    explicit JacobiPreconditioner(const Matrix& A) : invDiag(A.n) {
+        #pragma omp parallel for num_threads(threadsFor("precond"))
+        for (int i = 0; i < A.n; i++) {
+            invDiag[i] = 1.0 / A.at(i, i);
+        }
+    }
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override {
+        const int n = static_cast<int>(r.size());
+        #pragma omp parallel for num_threads(threadsFor("precond"))
+        for (int i = 0; i < n; i++) {
+            z[i] = invDiag[i] * r[i];
+        }
+    }
+
+private:
+    std::vector<double> invDiag;
+};
+
+// Блочный Якоби: диагональные блоки blockSize x blockSize, разложенные по Холецкому.
+// Каждый блок выделяется и раскладывается тем же потоком, что потом его применяет
+// (schedule(static) в обоих циклах), поэтому при first-touch блоки лежат в памяти
+// своего NUMA-узла.
+class BlockJacobiPreconditioner : public Preconditioner {
+public:
+    template <typename Matrix>
+    BlockJacobiPreconditioner(const Matrix& A, int blockSize)
+        : n(A.n), blockSize(blockSize), blocks((A.n + blockSize - 1) / blockSize) {
+        const int numBlocks = static_cast<int>(blocks.size());
+        #pragma omp parallel for num_threads(threadsFor("precond")) schedule(static)
+        for (int b = 0; b < numBlocks; b++) {
+            int first = b * blockSize;
+            int size = std::min(blockSize, n - first);
+            std::vector<double> L(static_cast<size_t>(size) * size, 0.0);
+            for (int i = 0; i < size; i++) {
+                for (int j = 0; j <= i; j++) {
+                    L[i * size + j] = A.at(first + i, first + j);
+                }
+            }
+            cholesky(L, size);
+            blocks[b] = std::move(L);
+        }
+    }
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override {
+        const int numBlocks = static_cast<int>(blocks.size());
+        #pragma omp parallel for num_threads(threadsFor("precond")) schedule(static)
+        for (int b = 0; b < numBlocks; b++) {
+            int first = b * blockSize;
+            int size = std::min(blockSize, n - first);
+            const std::vector<double>& L = blocks[b];
+            // L y = r
+            for (int i = 0; i < size; i++) {
+                double sum = r[first + i];
+                for (int j = 0; j < i; j++) {
+                    sum -= L[i * size + j] * z[first + j];
+                }
+                z[first + i] = sum / L[i * size + i];
+            }
+            // L^T z = y
+            for (int i = size - 1; i >= 0; i--) {
+                double sum = z[first + i];
+                for (int j = i + 1; j < size; j++) {
+                    sum -= L[j * size + i] * z[first + j];
+                }
+                z[first + i] = sum / L[i * size + i];
+            }
+        }
+    }
+
+private:
+    static void cholesky(std::vector<double>& L, int size) {
+        for (int j = 0; j < size; j++) {
+            double d = L[j * size + j];
+            for (int k = 0; k < j; k++) {
+                d -= L[j * size + k] * L[j * size + k];
+            }
+            if (d <= 0.0) {
+                throw std::runtime_error("BlockJacobiPreconditioner: block is not positive definite");
+            }
+            d = std::sqrt(d);
+            L[j * size + j] = d;
+            for (int i = j + 1; i < size; i++) {
+                double s = L[i * size + j];
+                for (int k = 0; k < j; k++) {
+                    s -= L[i * size + k] * L[j * size + k];
+                }
+                L[i * size + j] = s / d;
+            }
+        }
+    }
+
+    int n;
+    int blockSize;
+    std::vector<std::vector<double>> blocks;
+};
+
+// Симметричный SOR: M = omega/(2-omega) (D/omega + L) D^{-1} (D/omega + U).
+// Треугольные решения идут по панелям: диагональный блок решается одним потоком,
+// а обновление оставшейся правой части (основная работа, O(n^2)) - параллельно.
+class SSORPreconditioner : public Preconditioner {
+public:
+    SSORPreconditioner(const DenseMatrix& A, double omega, int panel = 256)
+        : A(A), omega(omega), panel(panel) {}
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override {
+        const int N = A.n;
+        const double* a = A.a.data();
+        std::vector<double> y(r);
+
+        #pragma omp parallel num_threads(threadsFor("precond"))
+        {
+            // (D/omega + L) y = r
+            for (int p = 0; p < N; p += panel) {
+                int end = std::min(p + panel, N);
+                #pragma omp single
+                for (int i = p; i < end; i++) {
+                    const double* row = a + static_cast<size_t>(i) * N;
+                    double sum = y[i];
+                    for (int j = p; j < i; j++) {
+                        sum -= row[j] * y[j];
+                    }
+                    y[i] = sum * omega / row[i];
+                }
+                #pragma omp for
+                for (int i = end; i < N; i++) {
+                    const double* row = a + static_cast<size_t>(i) * N;
+                    double sum = 0.0;
+                    for (int j = p; j < end; j++) {
+                        sum += row[j] * y[j];
+                    }
+                    y[i] -= sum;
+                }
+            }
+
+            #pragma omp for
+            for (int i = 0; i < N; i++) {
+                y[i] *= a[static_cast<size_t>(i) * N + i] * (2.0 - omega) / omega;
+            }
+
+            // (D/omega + U) z = y
+            for (int p = ((N - 1) / panel) * panel; p >= 0; p -= panel) {
+                int end = std::min(p + panel, N);
+                #pragma omp single
+                for (int i = end - 1; i >= p; i--) {
+                    const double* row = a + static_cast<size_t>(i) * N;
+                    double sum = y[i];
+                    for (int j = i + 1; j < end; j++) {
+                        sum -= row[j] * y[j];
+                    }
+                    y[i] = sum * omega / row[i];
+                }
+                #pragma omp for
+                for (int i = 0; i < p; i++) {
+                    const double* row = a + static_cast<size_t>(i) * N;
+                    double sum = 0.0;
+                    for (int j = p; j < end; j++) {
+                        sum += row[j] * y[j];
+                    }
+                    y[i] -= sum;
+                }
+            }
+        }
+        z.swap(y);
+    }
+
+private:
+    const DenseMatrix& A;
+    double omega;
+    int panel;
+};
+
+// Предобуславливатель по имени: none, jacobi, block, ssor
+inline std::unique_ptr<Preconditioner> makePreconditioner(const std::string& name, const DenseMatrix& A,
+                                                          int blockSize = 64, double omega = 1.0) {
+    if (name == "jacobi") {
+        return std::make_unique<JacobiPreconditioner>(A);
+    }
+    if (name == "block") {
+        return std::make_unique<BlockJacobiPreconditioner>(A, blockSize);
+    }
+    if (name == "ssor") {
+        return std::make_unique<SSORPreconditioner>(A, omega);
+    }
+    if (name == "none") {
+        return std::make_unique<IdentityPreconditioner>();
+    }
+    throw std::invalid_argument("Unknown preconditioner: " + name);
+}
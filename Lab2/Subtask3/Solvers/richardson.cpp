@@ -0,0 +1,67 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <string>
+
+#include "linalg.h"
+#include "spectral.h"
+#include "richardson.h"
+
+// Запуск: ./richardson [N] [richardson|chebyshev|team]
+// team - метод простой итерации в одной параллельной области с иерархическим барьером
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const std::string method = (argc > 2) ? argv[2] : "chebyshev";
+    const bool useChebyshev = (method == "chebyshev");
+
+    DenseMatrix A(N);
+    std::vector<double> B(N);
+    matrixInit(A);
+    vectorInit(B);
+
+    double epsilon = 0.00001;
+    int maxIter = 1000000;
+
+    for (int i = 0; i < 20; i++) {
+        std::vector<double> xprev(N, 0);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        SpectralBounds bounds = estimateSpectrum(A);
+        const auto estimated = std::chrono::steady_clock::now();
+
+        SolveStats stats;
+        if (useChebyshev) {
+            stats = chebyshev(A, B, xprev, bounds, epsilon, maxIter);
+        } else if (method == "team") {
+            stats = richardsonTeam(A, B, xprev, optimalTau(bounds), epsilon, maxIter);
+        } else {
+            stats = richardson(A, B, xprev, optimalTau(bounds), epsilon, maxIter);
+        }
+
+        const auto end = std::chrono::steady_clock::now();
+        const std::chrono::duration<double> estimate_seconds = estimated - start;
+        const std::chrono::duration<double> elapsed_seconds = end - start;
+
+        std::cout << "lmin = " << bounds.lmin << ", lmax = " << bounds.lmax
+                  << ", tau = " << optimalTau(bounds) << std::endl;
+        std::cout << "Iterations: " << stats.iterations
+                  << " (upper bound " << iterationBound(bounds, epsilon, useChebyshev) << ")"
+                  << ", error: " << stats.error << std::endl;
+        std::cout << "Time taken for estimation: " << estimate_seconds.count() << " seconds." << std::endl;
+        std::cout << "Time taken for solve: " << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "First elem: " << xprev[0] << std::endl;
+
+        std::ofstream file(method + ".csv", std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "Error: Unable to open file for writing." << std::endl;
+            return 1;
+        }
+        file << elapsed_seconds.count() << "," << stats.iterations << std::endl;
+        file.close();
+    }
+
+    return 0;
+}
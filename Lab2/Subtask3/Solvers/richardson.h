@@ -0,0 +1,236 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <memory>
+
+#include "linalg.h"
+#include "spectral.h"
+#include "precond.h"
+#include "convergence.h"
+#include "checkpoint.h"
+#include "barrier.h"
+
+struct SolveStats {
+    int iterations = 0;
+    double error = 0.0;  // ||B - Ax|| / ||B|| на выходе
+};
+
+// Метод простой итерации x = x + tau * (B - Ax).
+// Невязка, её норма (когда монитор её просит) и обновление x - в одном проходе после matvec.
+// В режиме lagged x обновляется и на итерации с проверкой, поэтому на выходе x на шаг
+// впереди проверенной невязки; error для него досчитывается одним умножением в конце.
+// checkpoint - периодические снимки x; если снимок уже есть, решение продолжается с него.
+template <typename Matrix>
+SolveStats richardson(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                      double tau, ConvergenceMonitor& monitor, int maxIter,
+                      Checkpointer* checkpoint = nullptr) {
+    const int N = A.n;
+    std::vector<double> r(N);
+
+    SolveStats stats;
+    SolverState state;
+    if (checkpoint && checkpoint->load("richardson", x.size(), state)) {
+        x = state.vectors[0];
+        stats.iterations = state.iteration;
+    }
+    for (; stats.iterations < maxIter; stats.iterations++) {
+        if (checkpoint && checkpoint->due(stats.iterations)) {
+            checkpoint->save("richardson", stats.iterations, {}, {&x});
+        }
+        const bool check = monitor.due(stats.iterations);
+        const bool update = !check || monitor.lagged();
+        matvec(A, x, r);
+        double rr = 0.0;
+        #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:rr)
+        for (int i = 0; i < N; i++) {
+            r[i] = B[i] - r[i];
+            if (check) {
+                rr += r[i] * r[i];
+            }
+            if (update) {
+                x[i] += tau * r[i];
+            }
+        }
+        if (check && monitor.report(stats.iterations, rr)) {
+            stats.iterations += update ? 1 : 0;
+            break;
+        }
+        if (!update) {
+            axpy(tau, r, x);
+        }
+    }
+    stats.error = finalError(monitor, stats.iterations, A, B, x, r);
+    return stats;
+}
+
+template <typename Matrix>
+SolveStats richardson(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                      double tau, double epsilon, int maxIter) {
+    ConvergenceMonitor monitor(B, epsilon);
+    return richardson(A, B, x, tau, monitor, maxIter);
+}
+
+// Частичная сумма потока, по одной кэш-линии на поток
+struct alignas(64) PartialSum {
+    double value = 0.0;
+};
+
+// Метод простой итерации одной командой потоков: параллельная область открывается один раз
+// на всё решение, поток t ведёт свой блок строк, а вместо fork/join двух циклов omp for на
+// каждой итерации - два иерархических барьера (barrier.h). Норму невязки каждый поток
+// складывает из частичных сумм сам, в одном порядке, поэтому все решают остановиться разом.
+template <typename Matrix>
+SolveStats richardsonTeam(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                          double tau, double epsilon, int maxIter) {
+    const int N = A.n;
+    std::vector<double> r(N);
+    const double normB = norm(B);
+    const double threshold = epsilon * epsilon * normB * normB;
+
+    SolveStats stats;
+    std::vector<PartialSum> partial;
+    std::unique_ptr<HierarchicalBarrier> barrier;
+    #pragma omp parallel num_threads(threadsFor("matvec", N))
+    {
+        const int threads = omp_get_num_threads();
+        const int t = omp_get_thread_num();
+        #pragma omp single
+        {
+            partial.resize(threads);
+            barrier = std::make_unique<HierarchicalBarrier>(threads, placementFromEnv(threads));
+        }
+        const int first = static_cast<int>(static_cast<long long>(N) * t / threads);
+        const int last = static_cast<int>(static_cast<long long>(N) * (t + 1) / threads);
+
+        for (int k = 0; k < maxIter; k++) {
+            double local = 0.0;
+            for (int i = first; i < last; i++) {
+                r[i] = B[i] - rowDot(A, i, x);
+                local += r[i] * r[i];
+            }
+            partial[t].value = local;
+            barrier->wait(t);
+
+            double rr = 0.0;
+            for (int s = 0; s < threads; s++) {
+                rr += partial[s].value;
+            }
+            if (t == 0) {
+                stats.iterations = k;
+                stats.error = std::sqrt(rr) / normB;
+            }
+            if (rr <= threshold) {
+                break;
+            }
+            for (int i = first; i < last; i++) {
+                x[i] += tau * r[i];
+            }
+            // x прочитают все, а partial перезапишут
+            barrier->wait(t);
+        }
+    }
+    if (stats.error > epsilon) {
+        // Последняя норма - до последнего обновления x
+        stats.iterations = maxIter;
+        stats.error = std::sqrt(residualNorm2(A, B, x, r)) / normB;
+    }
+    return stats;
+}
+
+// Метод простой итерации с предобуславливателем: x = x + tau * M^{-1} (B - Ax).
+// Шаг tau берётся по спектру M^{-1}A (estimateSpectrum(A, M)).
+template <typename Matrix>
+SolveStats richardson(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                      const Preconditioner& M, double tau, ConvergenceMonitor& monitor, int maxIter) {
+    const int N = A.n;
+    std::vector<double> r(N), z(N);
+
+    SolveStats stats;
+    for (stats.iterations = 0; stats.iterations < maxIter; stats.iterations++) {
+        if (monitor.due(stats.iterations)) {
+            if (monitor.report(stats.iterations, residualNorm2(A, B, x, r))) {
+                break;
+            }
+        } else {
+            residual(A, B, x, r);
+        }
+        M.apply(r, z);
+        axpy(tau, z, x);
+    }
+    stats.error = finalError(monitor, stats.iterations, A, B, x, r);
+    return stats;
+}
+
+template <typename Matrix>
+SolveStats richardson(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                      const Preconditioner& M, double tau, double epsilon, int maxIter) {
+    ConvergenceMonitor monitor(B, epsilon);
+    return richardson(A, B, x, M, tau, monitor, maxIter);
+}
+
+// Чебышёвское ускорение метода простой итерации по границам спектра [lmin, lmax].
+// Одно умножение на A за итерацию, как и у Ричардсона, но число итераций ~ sqrt(kappa).
+template <typename Matrix>
+SolveStats chebyshev(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                     const SpectralBounds& bounds, ConvergenceMonitor& monitor, int maxIter,
+                     Checkpointer* checkpoint = nullptr) {
+    const int N = A.n;
+    std::vector<double> r(N), d(N), Ad(N);
+
+    const double theta = 0.5 * (bounds.lmax + bounds.lmin);
+    const double delta = 0.5 * (bounds.lmax - bounds.lmin);
+    const double sigma = theta / delta;
+    double rho = 1.0 / sigma;
+
+    // В снимке x, r, d и rho: без них рекурсия Чебышёва начиналась бы заново
+    SolveStats stats;
+    SolverState state;
+    bool converged;
+    if (checkpoint && checkpoint->load("chebyshev", x.size(), state, 3, 1)) {
+        x = state.vectors[0];
+        r = state.vectors[1];
+        d = state.vectors[2];
+        rho = state.scalars.at(0);
+        stats.iterations = state.iteration;
+        converged = monitor.report(stats.iterations, dot(r, r));
+    } else {
+        converged = monitor.report(0, residualNorm2(A, B, x, r));
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            d[i] = r[i] / theta;
+        }
+    }
+
+    for (; stats.iterations < maxIter && !converged; stats.iterations++) {
+        if (checkpoint && checkpoint->due(stats.iterations)) {
+            checkpoint->save("chebyshev", stats.iterations, {rho}, {&x, &r, &d});
+        }
+        const bool check = monitor.due(stats.iterations + 1);
+        matvec(A, d, Ad);
+        double rhoNext = 1.0 / (2.0 * sigma - rho);
+        double rr = 0.0;
+        #pragma omp parallel for num_threads(threadsFor("vector")) reduction(+:rr)
+        for (int i = 0; i < N; i++) {
+            x[i] += d[i];
+            r[i] -= Ad[i];
+            d[i] = rhoNext * rho * d[i] + 2.0 * rhoNext / delta * r[i];
+            if (check) {
+                rr += r[i] * r[i];
+            }
+        }
+        rho = rhoNext;
+        if (check) {
+            converged = monitor.report(stats.iterations + 1, rr);
+        }
+    }
+    stats.error = finalError(monitor, stats.iterations, A, B, x, r);
+    return stats;
+}
+
+template <typename Matrix>
+SolveStats chebyshev(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                     const SpectralBounds& bounds, double epsilon, int maxIter) {
+    ConvergenceMonitor monitor(B, epsilon);
+    return chebyshev(A, B, x, bounds, monitor, maxIter);
+}
@@ -0,0 +1,137 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+
+#include "linalg.h"
+#include "spectral.h"
+#include "richardson.h"
+#include "stencil.h"
+#include "sor.h"
+
+// Сетка m x m, m = sqrt(N): многоцветный (красно-чёрный) SOR против последовательного
+// Гаусса-Зейделя в естественном порядке. Перед замерами один проход многоцветного SOR
+// сверяется с последовательным проходом в порядке цветов - результаты обязаны совпасть.
+int runGrid(int N, double omega) {
+    const int m = std::max(2, static_cast<int>(std::sqrt(static_cast<double>(N))));
+    Poisson A(m, m);
+    const Coloring coloring = redBlackColoring(m, m);
+    std::vector<double> B(A.n, 1.0);
+
+    std::vector<int> order;
+    for (const std::vector<int>& color : coloring.colors) {
+        order.insert(order.end(), color.begin(), color.end());
+    }
+    std::vector<double> xParallel(A.n), xSerial(A.n);
+    for (int i = 0; i < A.n; i++) {
+        xParallel[i] = xSerial[i] = std::sin(0.1 * i);
+    }
+    multicolorSorSweep(A, coloring, B, xParallel, omega);
+    sorSweepSerial(A, B, xSerial, omega, order);
+    double diff = 0.0;
+    for (int i = 0; i < A.n; i++) {
+        diff = std::max(diff, std::fabs(xParallel[i] - xSerial[i]));
+    }
+    std::cout << "Grid " << m << " x " << m << ", multicolor vs serial sweep, max diff: " << diff << std::endl;
+    if (diff > 1e-12) {
+        std::cerr << "Error: multicolor sweep differs from serial Gauss-Seidel." << std::endl;
+        return 1;
+    }
+
+    double epsilon = 0.00001;
+    int maxIter = 1000000;
+
+    std::ofstream file("sor.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    file << "Method,Omega,Iterations,Time (s)" << std::endl;
+
+    for (int i = 0; i < 20; i++) {
+        std::vector<double> xprev(A.n, 0);
+        auto start = std::chrono::steady_clock::now();
+        SolveStats stats = relax(A, B, xprev, [&](std::vector<double>& x) { sorSweepSerial(A, B, x, omega); },
+                                 epsilon, maxIter);
+        std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Serial SOR: " << stats.iterations << " iterations, "
+                  << elapsed_seconds.count() << " seconds." << std::endl;
+        file << "serial," << omega << "," << stats.iterations << "," << elapsed_seconds.count() << std::endl;
+
+        std::fill(xprev.begin(), xprev.end(), 0.0);
+        start = std::chrono::steady_clock::now();
+        stats = relax(A, B, xprev, [&](std::vector<double>& x) { multicolorSorSweep(A, coloring, B, x, omega); },
+                      epsilon, maxIter);
+        elapsed_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Multicolor SOR: " << stats.iterations << " iterations, "
+                  << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "First elem: " << xprev[0] << std::endl;
+        file << "multicolor," << omega << "," << stats.iterations << "," << elapsed_seconds.count() << std::endl;
+    }
+
+    file.close();
+    return 0;
+}
+
+// Запуск: ./sor [N] [omega] [scaled|grid]
+// Сравнивает метод простой итерации с оптимальным tau и SOR с параметром omega.
+// grid - разреженная сеточная матрица вместо плотной, см. runGrid.
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const double omega = (argc > 2) ? std::atof(argv[2]) : 1.0;
+    const std::string variant = (argc > 3) ? argv[3] : "";
+    const bool scaled = variant == "scaled";
+
+    if (variant == "grid") {
+        return runGrid(N, omega);
+    }
+
+    DenseMatrix A(N);
+    std::vector<double> B(N);
+    if (scaled) {
+        matrixInitScaled(A);
+    } else {
+        matrixInit(A);
+    }
+    vectorInit(B);
+
+    double epsilon = 0.00001;
+    int maxIter = 1000000;
+
+    std::ofstream file("sor.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    file << "Method,Omega,Iterations,Time (s)" << std::endl;
+
+    for (int i = 0; i < 20; i++) {
+        std::vector<double> xprev(N, 0);
+        auto start = std::chrono::steady_clock::now();
+        SolveStats stats = richardson(A, B, xprev, optimalTau(estimateSpectrum(A)), epsilon, maxIter);
+        std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Richardson: " << stats.iterations << " iterations, "
+                  << elapsed_seconds.count() << " seconds." << std::endl;
+        file << "richardson,," << stats.iterations << "," << elapsed_seconds.count() << std::endl;
+
+        std::fill(xprev.begin(), xprev.end(), 0.0);
+        start = std::chrono::steady_clock::now();
+        stats = relax(A, B, xprev, [&](std::vector<double>& x) { sorSweep(A, B, x, omega); },
+                      epsilon, maxIter);
+        elapsed_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "SOR: " << stats.iterations << " iterations, "
+                  << elapsed_seconds.count() << " seconds." << std::endl;
+        std::cout << "First elem: " << xprev[0] << std::endl;
+        file << "sor," << omega << "," << stats.iterations << "," << elapsed_seconds.count() << std::endl;
+    }
+
+    file.close();
+    return 0;
+}
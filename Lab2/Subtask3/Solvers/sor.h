@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "linalg.h"
+#include "richardson.h"
+#include "convergence.h"
+
+// Раскраска неизвестных: внутри одного цвета неизвестные не связаны между собой,
+// поэтому их можно обновлять одновременно.
+struct Coloring {
+    std::vector<std::vector<int>> colors;
+};
+
+// Красно-чёрная (шахматная) раскраска сетки nx x ny x nz, нумерация i + nx * (j + ny * k).
+// Подходит для 3/5/7-точечных шаблонов.
+inline Coloring redBlackColoring(int nx, int ny = 1, int nz = 1) {
+    Coloring coloring;
+    coloring.colors.resize(2);
+    for (int k = 0; k < nz; k++) {
+        for (int j = 0; j < ny; j++) {
+            for (int i = 0; i < nx; i++) {
+                coloring.colors[(i + j + k) % 2].push_back(i + nx * (j + ny * k));
+            }
+        }
+    }
+    return coloring;
+}
+
+// Один проход многоцветного SOR: цвета по очереди, внутри цвета - параллельно.
+// Для omega = 1 это метод Гаусса-Зейделя в раскрашенном порядке.
+template <typename Matrix>
+void multicolorSorSweep(const Matrix& A, const Coloring& coloring, const std::vector<double>& B,
+                        std::vector<double>& x, double omega) {
+    #pragma omp parallel num_threads(threadsFor("multicolor", A.n))
+    for (const std::vector<int>& color : coloring.colors) {
+        const int size = static_cast<int>(color.size());
+        #pragma omp for
+        for (int k = 0; k < size; k++) {
+            int i = color[k];
+            double diag = A.at(i, i);
+            double sigma = rowDot(A, i, x) - diag * x[i];
+            x[i] = (1.0 - omega) * x[i] + omega * (B[i] - sigma) / diag;
+        }
+    }
+}
+
+// Последовательный проход SOR в заданном порядке неизвестных (пустой order - естественный порядок).
+// Эталон для проверки параллельных проходов: многоцветный проход обязан совпасть
+// с последовательным в порядке цветов.
+template <typename Matrix>
+void sorSweepSerial(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                    double omega, const std::vector<int>& order = {}) {
+    const int size = order.empty() ? A.n : static_cast<int>(order.size());
+    for (int k = 0; k < size; k++) {
+        int i = order.empty() ? k : order[k];
+        double diag = A.at(i, i);
+        double sigma = rowDot(A, i, x) - diag * x[i];
+        x[i] = (1.0 - omega) * x[i] + omega * (B[i] - sigma) / diag;
+    }
+}
+
+// Один проход SOR в естественном порядке для плотной матрицы. У плотной матрицы все
+// неизвестные связаны, раскраски нет, поэтому параллелим по панелям: панель строк
+// обновляется одним потоком, а вклад новых значений панели в остальные строки
+// (основная работа) считается параллельно. За проход - одно чтение матрицы.
+// panel = 0 - ширина панели и число потоков из профиля машины (ядро "sor").
+inline void sorSweep(const DenseMatrix& A, const std::vector<double>& B, std::vector<double>& x,
+                     double omega, int panel = 0) {
+    const int N = A.n;
+    const double* a = A.a.data();
+    std::vector<double> s(N);
+    const KernelConfig config = tuned("sor", N);
+    if (panel <= 0) {
+        panel = (config.block > 0) ? config.block : 256;
+    }
+
+    #pragma omp parallel num_threads(config.threads)
+    {
+        // s_i = b_i - вклад старых значений из панелей правее панели строки i
+        #pragma omp for
+        for (int i = 0; i < N; i++) {
+            const double* row = a + static_cast<size_t>(i) * N;
+            int end = std::min((i / panel + 1) * panel, N);
+            double sum = B[i];
+            for (int j = end; j < N; j++) {
+                sum -= row[j] * x[j];
+            }
+            s[i] = sum;
+        }
+
+        for (int p = 0; p < N; p += panel) {
+            int end = std::min(p + panel, N);
+            #pragma omp single
+            for (int i = p; i < end; i++) {
+                const double* row = a + static_cast<size_t>(i) * N;
+                double sigma = s[i];
+                for (int j = p; j < end; j++) {
+                    if (j != i) {
+                        sigma -= row[j] * x[j];
+                    }
+                }
+                x[i] = (1.0 - omega) * x[i] + omega * sigma / row[i];
+            }
+            #pragma omp for
+            for (int i = end; i < N; i++) {
+                const double* row = a + static_cast<size_t>(i) * N;
+                double sum = 0.0;
+                for (int j = p; j < end; j++) {
+                    sum += row[j] * x[j];
+                }
+                s[i] -= sum;
+            }
+        }
+    }
+}
+
+// Релаксация до сходимости: sweep(x) - один проход сглаживателя.
+// Невязка нужна только для проверки, поэтому между проверками монитора она не считается.
+template <typename Matrix, typename Sweep>
+SolveStats relax(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                 Sweep sweep, ConvergenceMonitor& monitor, int maxIter) {
+    std::vector<double> r(A.n);
+
+    SolveStats stats;
+    for (stats.iterations = 0; stats.iterations < maxIter; stats.iterations++) {
+        if (monitor.due(stats.iterations) && monitor.report(stats.iterations, residualNorm2(A, B, x, r))) {
+            break;
+        }
+        sweep(x);
+    }
+    stats.error = finalError(monitor, stats.iterations, A, B, x, r);
+    return stats;
+}
+
+template <typename Matrix, typename Sweep>
+SolveStats relax(const Matrix& A, const std::vector<double>& B, std::vector<double>& x,
+                 Sweep sweep, double epsilon, int maxIter) {
+    ConvergenceMonitor monitor(B, epsilon);
+    return relax(A, B, x, sweep, monitor, maxIter);
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <numeric>
+
+#include "linalg.h"
+
+// Разреженная матрица n x n в формате CSR, столбцы в строке отсортированы
+struct CSRMatrix {
+    int n = 0;
+    std::vector<size_t> rowPtr;   // n + 1
+    std::vector<int> col;
+    std::vector<double> val;
+
+    size_t nnz() const { return val.size(); }
+
+    double at(int i, int j) const {
+        auto first = col.begin() + rowPtr[i];
+        auto last = col.begin() + rowPtr[i + 1];
+        auto it = std::lower_bound(first, last, j);
+        return (it != last && *it == j) ? val[it - col.begin()] : 0.0;
+    }
+};
+
+// Разбиение [0, count) на parts кусков с примерно равной суммой весов.
+// ptr - префиксные суммы весов (rowPtr для CSR, chunkPtr для SELL).
+inline std::vector<int> balancedPartition(const std::vector<size_t>& ptr, int parts) {
+    const int count = static_cast<int>(ptr.size()) - 1;
+    std::vector<int> bounds(parts + 1, count);
+    bounds[0] = 0;
+    for (int p = 1; p < parts; p++) {
+        size_t target = ptr[count] / parts * p + ptr[count] % parts * p / parts;
+        bounds[p] = static_cast<int>(std::lower_bound(ptr.begin(), ptr.end(), target) - ptr.begin());
+        bounds[p] = std::max(bounds[p - 1], std::min(bounds[p], count));
+    }
+    return bounds;
+}
+
+// Разбиение строк по потокам с равным числом ненулей
+inline std::vector<int> rowPartition(const CSRMatrix& A, int parts = threadsFor("spmv")) {
+    return balancedPartition(A.rowPtr, parts);
+}
+
+// y = A * x, строки поделены между потоками по числу ненулей
+inline void matvec(const CSRMatrix& A, const std::vector<double>& x, std::vector<double>& y,
+                   const std::vector<int>& bounds) {
+    const int parts = static_cast<int>(bounds.size()) - 1;
+    #pragma omp parallel num_threads(parts)
+    for (int t = omp_get_thread_num(); t < parts; t += omp_get_num_threads()) {
+        for (int i = bounds[t]; i < bounds[t + 1]; i++) {
+            double sum = 0.0;
+            for (size_t k = A.rowPtr[i]; k < A.rowPtr[i + 1]; k++) {
+                sum += A.val[k] * x[A.col[k]];
+            }
+            y[i] = sum;
+        }
+    }
+}
+
+inline void matvec(const CSRMatrix& A, const std::vector<double>& x, std::vector<double>& y) {
+    matvec(A, x, y, rowPartition(A));
+}
+
+template <typename Vec>
+double rowDot(const CSRMatrix& A, int i, const Vec& x) {
+    double sum = 0.0;
+    for (size_t k = A.rowPtr[i]; k < A.rowPtr[i + 1]; k++) {
+        sum += A.val[k] * x[A.col[k]];
+    }
+    return sum;
+}
+
+// SELL-C-sigma: строки сортируются по длине внутри окон из sigma строк и
+// группируются в куски по C строк. Кусок хранится по столбцам (C значений подряд),
+// ширина куска - самая длинная строка в нём, короткие строки добиваются нулями.
+// Внутренний цикл по C строкам куска векторизуется.
+struct SELLMatrix {
+    static constexpr int C = 8;
+
+    int n = 0;
+    int sigma = 1;
+    std::vector<size_t> chunkPtr;   // начало куска в val/col, chunks + 1
+    std::vector<int> chunkWidth;
+    std::vector<int> perm;          // строка в порядке SELL -> исходная строка
+    std::vector<int> col;
+    std::vector<double> val;
+
+    int chunks() const { return static_cast<int>(chunkWidth.size()); }
+};
+
+inline SELLMatrix toSELL(const CSRMatrix& A, int sigma = 256) {
+    constexpr int C = SELLMatrix::C;
+    SELLMatrix S;
+    S.n = A.n;
+    S.sigma = std::max(sigma, 1);
+
+    const int chunks = (A.n + C - 1) / C;
+    S.perm.resize(static_cast<size_t>(chunks) * C);
+    std::iota(S.perm.begin(), S.perm.end(), 0);
+
+    auto length = [&A](int i) { return (i < A.n) ? A.rowPtr[i + 1] - A.rowPtr[i] : size_t(0); };
+    #pragma omp parallel for num_threads(threadsFor("spmv"))
+    for (int w = 0; w < (static_cast<int>(S.perm.size()) + S.sigma - 1) / S.sigma; w++) {
+        auto first = S.perm.begin() + static_cast<size_t>(w) * S.sigma;
+        auto last = S.perm.begin() + std::min(S.perm.size(), static_cast<size_t>(w + 1) * S.sigma);
+        std::stable_sort(first, last, [&](int a, int b) { return length(a) > length(b); });
+    }
+
+    S.chunkWidth.resize(chunks);
+    S.chunkPtr.assign(chunks + 1, 0);
+    for (int c = 0; c < chunks; c++) {
+        size_t width = 0;
+        for (int r = 0; r < C; r++) {
+            width = std::max(width, length(S.perm[c * C + r]));
+        }
+        S.chunkWidth[c] = static_cast<int>(width);
+        S.chunkPtr[c + 1] = S.chunkPtr[c] + width * C;
+    }
+
+    S.col.resize(S.chunkPtr[chunks]);
+    S.val.resize(S.chunkPtr[chunks]);
+    #pragma omp parallel for num_threads(threadsFor("spmv"))
+    for (int c = 0; c < chunks; c++) {
+        for (int r = 0; r < C; r++) {
+            int i = S.perm[c * C + r];
+            size_t len = length(i);
+            for (int j = 0; j < S.chunkWidth[c]; j++) {
+                size_t k = S.chunkPtr[c] + static_cast<size_t>(j) * C + r;
+                if (static_cast<size_t>(j) < len) {
+                    S.col[k] = A.col[A.rowPtr[i] + j];
+                    S.val[k] = A.val[A.rowPtr[i] + j];
+                } else {
+                    S.col[k] = 0;
+                    S.val[k] = 0.0;
+                }
+            }
+        }
+    }
+    return S;
+}
+
+inline void matvec(const SELLMatrix& S, const std::vector<double>& x, std::vector<double>& y,
+                   const std::vector<int>& bounds) {
+    constexpr int C = SELLMatrix::C;
+    const int parts = static_cast<int>(bounds.size()) - 1;
+    #pragma omp parallel num_threads(parts)
+    for (int t = omp_get_thread_num(); t < parts; t += omp_get_num_threads()) {
+        for (int c = bounds[t]; c < bounds[t + 1]; c++) {
+            double sum[C] = {};
+            const double* v = S.val.data() + S.chunkPtr[c];
+            const int* cl = S.col.data() + S.chunkPtr[c];
+            for (int j = 0; j < S.chunkWidth[c]; j++) {
+                #pragma omp simd
+                for (int r = 0; r < C; r++) {
+                    sum[r] += v[j * C + r] * x[cl[j * C + r]];
+                }
+            }
+            for (int r = 0; r < C; r++) {
+                int i = S.perm[c * C + r];
+                if (i < S.n) {
+                    y[i] = sum[r];
+                }
+            }
+        }
+    }
+}
+
+inline void matvec(const SELLMatrix& S, const std::vector<double>& x, std::vector<double>& y) {
+    matvec(S, x, y, balancedPartition(S.chunkPtr, threadsFor("spmv")));
+}
+
+// Та же сигнатура, что у multiplication() из Lab2/Subtask1, но для разреженных матриц
+inline std::vector<double> multiplication(const std::vector<double>& vector, const CSRMatrix& matrix) {
+    std::vector<double> result(matrix.n);
+    matvec(matrix, vector, result);
+    return result;
+}
+
+inline std::vector<double> multiplication(const std::vector<double>& vector, const SELLMatrix& matrix) {
+    std::vector<double> result(matrix.n);
+    matvec(matrix, vector, result);
+    return result;
+}
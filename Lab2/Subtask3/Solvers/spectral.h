@@ -0,0 +1,133 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+#include "linalg.h"
+#include "precond.h"
+
+// Оценка границ спектра симметричной положительно определённой матрицы
+struct SpectralBounds {
+    double lmin = 0.0;
+    double lmax = 0.0;
+
+    double condition() const { return lmax / lmin; }
+};
+
+// Число собственных значений трёхдиагональной матрицы меньше x (последовательность Штурма)
+inline int sturmCount(const std::vector<double>& alpha, const std::vector<double>& beta, double x) {
+    int count = 0;
+    double d = 1.0;
+    for (size_t i = 0; i < alpha.size(); i++) {
+        double b2 = (i == 0) ? 0.0 : beta[i - 1] * beta[i - 1];
+        d = alpha[i] - x - b2 / d;
+        if (d == 0.0) {
+            d = 1e-300;
+        }
+        if (d < 0.0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// k-е по возрастанию собственное значение трёхдиагональной матрицы (бисекция)
+inline double tridiagEigenvalue(const std::vector<double>& alpha, const std::vector<double>& beta, int k) {
+    double lo = alpha[0], hi = alpha[0];
+    for (size_t i = 0; i < alpha.size(); i++) {
+        double r = 0.0;
+        if (i > 0) r += std::fabs(beta[i - 1]);
+        if (i + 1 < alpha.size()) r += std::fabs(beta[i]);
+        lo = std::min(lo, alpha[i] - r);
+        hi = std::max(hi, alpha[i] + r);
+    }
+    for (int it = 0; it < 200 && hi - lo > 1e-12 * std::max(std::fabs(lo), std::fabs(hi)); it++) {
+        double mid = 0.5 * (lo + hi);
+        if (sturmCount(alpha, beta, mid) > k) {
+            hi = mid;
+        } else {
+            lo = mid;
+        }
+    }
+    return 0.5 * (lo + hi);
+}
+
+// Метод Ланцоша для M^{-1}A (скалярное произведение, порождённое M): крайние числа Ритца
+// дают оценки lmin и lmax за steps умножений на A. lmax немного завышаем, чтобы шаг tau
+// гарантированно не приводил к расхождению.
+template <typename Matrix>
+SpectralBounds estimateSpectrum(const Matrix& A, const Preconditioner& M, int steps = 30, double margin = 1.01) {
+    const int N = A.n;
+    std::vector<double> v(N), vprev(N, 0.0), u(N), w(N), z(N);
+
+    std::minstd_rand gen(12345);
+    std::uniform_real_distribution<double> dis(-1.0, 1.0);
+    for (int i = 0; i < N; i++) {
+        v[i] = dis(gen);
+    }
+    M.apply(v, u);
+    double b = std::sqrt(dot(v, u));
+    #pragma omp parallel for num_threads(threadsFor("vector"))
+    for (int i = 0; i < N; i++) {
+        v[i] /= b;
+        u[i] /= b;
+    }
+
+    std::vector<double> alpha, beta;
+    b = 0.0;
+    for (int k = 0; k < std::min(steps, N); k++) {
+        matvec(A, u, w);
+        double a = dot(w, u);
+        alpha.push_back(a);
+
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            w[i] -= a * v[i] + b * vprev[i];
+        }
+        M.apply(w, z);
+        b = std::sqrt(std::max(dot(w, z), 0.0));
+        // Пространство Крылова исчерпано: числа Ритца точные
+        if (b <= 1e-12 * std::fabs(a)) {
+            break;
+        }
+        beta.push_back(b);
+
+        #pragma omp parallel for num_threads(threadsFor("vector"))
+        for (int i = 0; i < N; i++) {
+            vprev[i] = v[i];
+            v[i] = w[i] / b;
+            u[i] = z[i] / b;
+        }
+    }
+    beta.resize(alpha.size() > 0 ? alpha.size() - 1 : 0);
+
+    SpectralBounds bounds;
+    bounds.lmin = tridiagEigenvalue(alpha, beta, 0);
+    bounds.lmax = tridiagEigenvalue(alpha, beta, static_cast<int>(alpha.size()) - 1) * margin;
+    return bounds;
+}
+
+template <typename Matrix>
+SpectralBounds estimateSpectrum(const Matrix& A, int steps = 30, double margin = 1.01) {
+    return estimateSpectrum(A, IdentityPreconditioner(), steps, margin);
+}
+
+// Оптимальный шаг метода простой итерации: tau = 2 / (lmin + lmax)
+inline double optimalTau(const SpectralBounds& bounds) {
+    return 2.0 / (bounds.lmin + bounds.lmax);
+}
+
+// Верхняя оценка числа итераций до относительной невязки epsilon: худший случай по числу
+// обусловленности, на практике итераций обычно в разы меньше
+inline int iterationBound(const SpectralBounds& bounds, double epsilon, bool chebyshev) {
+    double kappa = bounds.condition();
+    double q = chebyshev ? (std::sqrt(kappa) - 1.0) / (std::sqrt(kappa) + 1.0)
+                         : (kappa - 1.0) / (kappa + 1.0);
+    if (q <= 0.0) {
+        return 1;
+    }
+    double target = chebyshev ? epsilon / 2.0 : epsilon;
+    return static_cast<int>(std::ceil(std::log(target) / std::log(q)));
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <utility>
+
+#include "linalg.h"
+#include "sparse.h"
+
+// Строка i случайной матрицы: от 1 до 2 * perRow ненулей (чтобы SELL было что сортировать),
+// столбцы отсортированы. Генератор зависит только от i, поэтому оба прохода построения
+// CSR и любое число потоков дают одну и ту же матрицу.
+static void randomRow(int i, int N, int perRow, std::vector<int>& cols, std::vector<double>& vals) {
+    std::minstd_rand local_gen(12345 + i);
+    int count = 1 + static_cast<int>(local_gen() % (2 * perRow));
+    std::vector<std::pair<int, double>> entries(count);
+    for (std::pair<int, double>& entry : entries) {
+        entry.first = static_cast<int>(local_gen() % N);
+        entry.second = 1 + local_gen() % 99;
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](const std::pair<int, double>& a, const std::pair<int, double>& b) { return a.first < b.first; });
+    cols.clear();
+    vals.clear();
+    for (const std::pair<int, double>& entry : entries) {
+        if (!cols.empty() && cols.back() == entry.first) {
+            vals.back() = entry.second;
+        } else {
+            cols.push_back(entry.first);
+            vals.push_back(entry.second);
+        }
+    }
+}
+
+// Запуск: ./spmv [N] [ненулей в строке] [dense]
+// Сравнивает CSR и SELL-C-sigma на одной и той же матрице. CSR строится сразу по строкам,
+// плотная копия (N^2 * 8 байт) создаётся только с ключом dense - для сравнения с плотным умножением.
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const int perRow = (argc > 2) ? std::atoi(argv[2]) : 50;
+    const bool withDense = (argc > 3) && std::string(argv[3]) == "dense";
+
+    CSRMatrix A;
+    A.n = N;
+    A.rowPtr.assign(N + 1, 0);
+    std::vector<double> vector(N);
+
+    // Два прохода: число ненулей в строках, затем заполнение своих участков col/val
+    #pragma omp parallel num_threads(NUMBER_OF_THREADS)
+    {
+        std::vector<int> cols;
+        std::vector<double> vals;
+        #pragma omp for
+        for (int i = 0; i < N; i++) {
+            randomRow(i, N, perRow, cols, vals);
+            A.rowPtr[i + 1] = cols.size();
+            vector[i] = i % 100;
+        }
+        #pragma omp single
+        {
+            std::partial_sum(A.rowPtr.begin(), A.rowPtr.end(), A.rowPtr.begin());
+            A.col.resize(A.rowPtr[N]);
+            A.val.resize(A.rowPtr[N]);
+        }
+        #pragma omp for
+        for (int i = 0; i < N; i++) {
+            randomRow(i, N, perRow, cols, vals);
+            std::copy(cols.begin(), cols.end(), A.col.begin() + A.rowPtr[i]);
+            std::copy(vals.begin(), vals.end(), A.val.begin() + A.rowPtr[i]);
+        }
+    }
+
+    SELLMatrix S = toSELL(A);
+    std::cout << "nnz: " << A.nnz() << " (" << 100.0 * A.nnz() / (static_cast<double>(N) * N) << "%)"
+              << ", SELL padding: " << 100.0 * (S.val.size() - A.nnz()) / A.nnz() << "%" << std::endl;
+
+    DenseMatrix D;
+    if (withDense) {
+        D = DenseMatrix(N);
+        #pragma omp parallel for num_threads(NUMBER_OF_THREADS)
+        for (int i = 0; i < N; i++) {
+            for (size_t k = A.rowPtr[i]; k < A.rowPtr[i + 1]; k++) {
+                D.a[static_cast<size_t>(i) * N + A.col[k]] = A.val[k];
+            }
+        }
+    }
+
+    // Эталон для проверки - последовательное умножение по строкам CSR
+    std::vector<double> reference(N);
+    for (int i = 0; i < N; i++) {
+        double sum = 0.0;
+        for (size_t k = A.rowPtr[i]; k < A.rowPtr[i + 1]; k++) {
+            sum += A.val[k] * vector[A.col[k]];
+        }
+        reference[i] = sum;
+    }
+
+    std::vector<double> dense(N);
+    std::ofstream file("spmv.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    for (int i = 0; i < 20; i++) {
+        auto start = std::chrono::steady_clock::now();
+        if (withDense) {
+            matvec(D, vector, dense);
+        }
+        std::chrono::duration<double> dense_seconds = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        std::vector<double> csr = multiplication(vector, A);
+        std::chrono::duration<double> csr_seconds = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        std::vector<double> sell = multiplication(vector, S);
+        std::chrono::duration<double> sell_seconds = std::chrono::steady_clock::now() - start;
+
+        double diff = 0.0;
+        for (int k = 0; k < N; k++) {
+            diff = std::max(diff, std::max(std::fabs(csr[k] - reference[k]), std::fabs(sell[k] - reference[k])));
+            if (withDense) {
+                diff = std::max(diff, std::fabs(dense[k] - reference[k]));
+            }
+        }
+
+        if (withDense) {
+            std::cout << "Dense: " << dense_seconds.count() << " s, ";
+        }
+        std::cout << "CSR: " << csr_seconds.count()
+                  << " s, SELL: " << sell_seconds.count() << " s, max diff: " << diff << std::endl;
+        file << dense_seconds.count() << "," << csr_seconds.count() << "," << sell_seconds.count() << std::endl;
+    }
+
+    file.close();
+    return 0;
+}
@@ -0,0 +1,302 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+
+#include "linalg.h"
+#include "richardson.h"
+
+// Аллокатор, который не зануляет элементы при создании вектора. Память тогда
+// "трогает" первым тот поток, который первым пишет в неё (first-touch), и страницы
+// попадают на его NUMA-узел.
+template <typename T>
+struct DefaultInitAllocator : std::allocator<T> {
+    template <typename U>
+    struct rebind { using other = DefaultInitAllocator<U>; };
+
+    DefaultInitAllocator() = default;
+    template <typename U>
+    DefaultInitAllocator(const DefaultInitAllocator<U>&) {}
+
+    template <typename U>
+    void construct(U* p) { ::new (static_cast<void*>(p)) U; }
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+};
+
+using Field = std::vector<double, DefaultInitAllocator<double>>;
+
+// Матрица-оператор 5-точечного (nz = 1) или 7-точечного шаблона для -Laplace
+// с нулевыми условиями Дирихле: (A u)_p = 2d u_p - sum_{соседи q} u_q.
+// Матрица не хранится; нумерация p = x + nx * (y + ny * z).
+struct Poisson {
+    int nx = 0, ny = 0, nz = 1;
+    int n = 0;
+
+    Poisson(int nx, int ny, int nz = 1) : nx(nx), ny(ny), nz(nz), n(nx * ny * nz) {}
+
+    int dim() const { return nz > 1 ? 3 : 2; }
+    double diag() const { return 2.0 * dim(); }
+
+    // Внешнее измерение, по которому режем область между потоками и идёт волна
+    int planes() const { return nz > 1 ? nz : ny; }
+    // Строк x в одной плоскости
+    int rowsPerPlane() const { return nz > 1 ? ny : 1; }
+
+    double at(int i, int j) const {
+        if (i == j) {
+            return diag();
+        }
+        int d = std::abs(i - j);
+        int lo = std::min(i, j);
+        if (d == 1) {
+            return (lo % nx != nx - 1) ? -1.0 : 0.0;
+        }
+        if (d == nx) {
+            return ((lo / nx) % ny != ny - 1) ? -1.0 : 0.0;
+        }
+        if (d == nx * ny && nz > 1) {
+            return -1.0;
+        }
+        return 0.0;
+    }
+};
+
+// Разбиение внешнего измерения на непрерывные слои по потокам. Один и тот же поток
+// всегда обрабатывает свой слой: при инициализации, в сглаживании и в умножении.
+inline std::pair<int, int> ownedPlanes(const Poisson& A, int thread, int threads) {
+    int planes = A.planes();
+    return {static_cast<int>(static_cast<long long>(planes) * thread / threads),
+            static_cast<int>(static_cast<long long>(planes) * (thread + 1) / threads)};
+}
+
+// Число потоков-владельцев слоёв сетки (ядро "stencil" из профиля машины). Одно и то же
+// для первого касания поля и для всех проходов по нему, иначе разбиение ownedPlanes
+// при проходе не совпадёт с размещением страниц по NUMA-узлам.
+inline int stencilOwners(const Poisson& A) {
+    return tuned("stencil", A.n).threads;
+}
+
+// Поле на сетке, размещённое по NUMA-узлам потоков-владельцев
+inline Field makeField(const Poisson& A, double value = 0.0) {
+    Field u(A.n);
+    const size_t rowsPerPlane = A.rowsPerPlane();
+    #pragma omp parallel num_threads(stencilOwners(A))
+    {
+        std::pair<int, int> own = ownedPlanes(A, omp_get_thread_num(), omp_get_num_threads());
+        size_t first = static_cast<size_t>(own.first) * rowsPerPlane * A.nx;
+        size_t last = static_cast<size_t>(own.second) * rowsPerPlane * A.nx;
+        std::fill(u.begin() + first, u.begin() + last, value);
+    }
+    return u;
+}
+
+// Одна строка x в [x0, x1) для строки (y, z): взвешенный Якоби или умножение на A.
+// src - старые значения, dst - новые; f - правая часть (только для Якоби).
+template <bool Jacobi>
+inline void stencilRow(const Poisson& A, const double* src, double* dst, const double* f,
+                       int y, int z, int x0, int x1, double omega) {
+    const int nx = A.nx;
+    const size_t plane = static_cast<size_t>(nx) * A.ny;
+    const size_t base = static_cast<size_t>(nx) * (y + static_cast<size_t>(A.ny) * z);
+    const double* s = src + base;
+    const double* south = (y > 0) ? s - nx : nullptr;
+    const double* north = (y < A.ny - 1) ? s + nx : nullptr;
+    const double* below = (A.nz > 1 && z > 0) ? s - plane : nullptr;
+    const double* above = (A.nz > 1 && z < A.nz - 1) ? s + plane : nullptr;
+    const double diag = A.diag();
+
+    for (int x = x0; x < x1; x++) {
+        double sum = 0.0;
+        if (x > 0) sum += s[x - 1];
+        if (x < nx - 1) sum += s[x + 1];
+        if (south) sum += south[x];
+        if (north) sum += north[x];
+        if (below) sum += below[x];
+        if (above) sum += above[x];
+        if (Jacobi) {
+            dst[base + x] = (1.0 - omega) * s[x] + omega * (f[base + x] + sum) / diag;
+        } else {
+            dst[base + x] = diag * s[x] - sum;
+        }
+    }
+}
+
+// Проход по своему слою с пространственной блокировкой: блок из blockY строк
+// проходится по всем плоскостям слоя, так что три соседние плоскости блока
+// остаются в кэше.
+template <bool Jacobi>
+inline void stencilSweepOwned(const Poisson& A, const double* src, double* dst, const double* f,
+                              double omega, int blockY) {
+    std::pair<int, int> own = ownedPlanes(A, omp_get_thread_num(), omp_get_num_threads());
+    if (A.nz > 1) {
+        for (int y0 = 0; y0 < A.ny; y0 += blockY) {
+            int y1 = std::min(y0 + blockY, A.ny);
+            for (int z = own.first; z < own.second; z++) {
+                for (int y = y0; y < y1; y++) {
+                    stencilRow<Jacobi>(A, src, dst, f, y, z, 0, A.nx, omega);
+                }
+            }
+        }
+    } else {
+        for (int y = own.first; y < own.second; y++) {
+            stencilRow<Jacobi>(A, src, dst, f, y, 0, 0, A.nx, omega);
+        }
+    }
+}
+
+// Число потоков и blockY для проходов по сетке: из профиля машины (ядро "stencil"),
+// blockY > 0 в аргументах ядра имеет приоритет
+inline KernelConfig stencilConfig(const Poisson& A, int blockY) {
+    KernelConfig config = tuned("stencil", A.n);
+    config.threads = stencilOwners(A);
+    config.block = (blockY > 0) ? blockY : ((config.block > 0) ? config.block : 16);
+    return config;
+}
+
+// y = A * x без хранения матрицы
+template <typename Vec>
+void matvec(const Poisson& A, const Vec& x, Vec& y, int blockY = 0) {
+    const KernelConfig config = stencilConfig(A, blockY);
+    #pragma omp parallel num_threads(config.threads)
+    stencilSweepOwned<false>(A, x.data(), y.data(), nullptr, 0.0, config.block);
+}
+
+template <typename Vec>
+double rowDot(const Poisson& A, int i, const Vec& x) {
+    int xi = i % A.nx;
+    int yi = (i / A.nx) % A.ny;
+    int zi = i / (A.nx * A.ny);
+    const int plane = A.nx * A.ny;
+    double sum = A.diag() * x[i];
+    if (xi > 0) sum -= x[i - 1];
+    if (xi < A.nx - 1) sum -= x[i + 1];
+    if (yi > 0) sum -= x[i - A.nx];
+    if (yi < A.ny - 1) sum -= x[i + A.nx];
+    if (A.nz > 1 && zi > 0) sum -= x[i - plane];
+    if (A.nz > 1 && zi < A.nz - 1) sum -= x[i + plane];
+    return sum;
+}
+
+// Красно-чёрный SOR на месте: точки с чётной суммой координат зависят только от
+// нечётных и наоборот, поэтому каждый цвет обновляется параллельно без гонок.
+// Каждый поток обрабатывает свой слой плоскостей.
+inline void redBlackSweep(const Poisson& A, const Field& f, Field& u, double omega = 1.0) {
+    const int nx = A.nx;
+    const size_t plane = static_cast<size_t>(nx) * A.ny;
+    const double diag = A.diag();
+
+    #pragma omp parallel num_threads(stencilOwners(A))
+    {
+        std::pair<int, int> own = ownedPlanes(A, omp_get_thread_num(), omp_get_num_threads());
+        for (int color = 0; color < 2; color++) {
+            for (int p = own.first; p < own.second; p++) {
+                for (int r = 0; r < A.rowsPerPlane(); r++) {
+                    int y = (A.nz > 1) ? r : p;
+                    int z = (A.nz > 1) ? p : 0;
+                    const size_t base = static_cast<size_t>(nx) * (y + static_cast<size_t>(A.ny) * z);
+                    double* s = u.data() + base;
+                    const double* south = (y > 0) ? s - nx : nullptr;
+                    const double* north = (y < A.ny - 1) ? s + nx : nullptr;
+                    const double* below = (A.nz > 1 && z > 0) ? s - plane : nullptr;
+                    const double* above = (A.nz > 1 && z < A.nz - 1) ? s + plane : nullptr;
+                    for (int x = (color + y + z) % 2; x < nx; x += 2) {
+                        double sum = 0.0;
+                        if (x > 0) sum += s[x - 1];
+                        if (x < nx - 1) sum += s[x + 1];
+                        if (south) sum += south[x];
+                        if (north) sum += north[x];
+                        if (below) sum += below[x];
+                        if (above) sum += above[x];
+                        s[x] = (1.0 - omega) * s[x] + omega * (f[base + x] + sum) / diag;
+                    }
+                }
+            }
+            #pragma omp barrier
+        }
+    }
+}
+
+// sweeps проходов взвешенного Якоби с пространственной блокировкой, по одному
+// чтению сетки на проход. Результат остаётся в u, tmp - рабочий буфер.
+inline void jacobiSweeps(const Poisson& A, const Field& f, Field& u, Field& tmp,
+                         int sweeps, double omega = 1.0, int blockY = 0) {
+    const KernelConfig config = stencilConfig(A, blockY);
+    for (int s = 0; s < sweeps; s++) {
+        #pragma omp parallel num_threads(config.threads)
+        stencilSweepOwned<true>(A, u.data(), tmp.data(), f.data(), omega, config.block);
+        u.swap(tmp);
+    }
+}
+
+// sweeps проходов Якоби с временной блокировкой (волновой фронт по внешнему измерению).
+// На шаге волны w уровень t (1..sweeps) обновляет плоскость w - 2(t-1). При отставании
+// на две плоскости все уровни одного шага независимы и считаются параллельно, а между
+// уровнями данные ходят через кэш: сетка читается из памяти один раз на sweeps проходов.
+// Уровень t пишет в буфер t % 2, так что хватает двух массивов.
+inline void jacobiWavefront(const Poisson& A, const Field& f, Field& u, Field& tmp,
+                            int sweeps, double omega = 1.0, int segments = NUMBER_OF_THREADS) {
+    const int planes = A.planes();
+    const int rows = A.rowsPerPlane();
+    // Для 2-D плоскость - одна строка, её режем на отрезки по x
+    const int parts = (A.nz > 1) ? rows : std::max(1, std::min(segments, A.nx));
+    double* buf[2] = {u.data(), tmp.data()};
+    const int waves = planes + 2 * (sweeps - 1);
+
+    #pragma omp parallel num_threads(stencilOwners(A))
+    for (int w = 0; w < waves; w++) {
+        #pragma omp for collapse(2) schedule(static)
+        for (int t = 1; t <= sweeps; t++) {
+            for (int part = 0; part < parts; part++) {
+                int p = w - 2 * (t - 1);
+                if (p < 0 || p >= planes) {
+                    continue;
+                }
+                const double* src = buf[(t - 1) % 2];
+                double* dst = buf[t % 2];
+                if (A.nz > 1) {
+                    stencilRow<true>(A, src, dst, f.data(), part, p, 0, A.nx, omega);
+                } else {
+                    int x0 = static_cast<int>(static_cast<long long>(A.nx) * part / parts);
+                    int x1 = static_cast<int>(static_cast<long long>(A.nx) * (part + 1) / parts);
+                    stencilRow<true>(A, src, dst, f.data(), p, 0, x0, x1, omega);
+                }
+            }
+        }
+    }
+    if (sweeps % 2 == 1) {
+        u.swap(tmp);
+    }
+}
+
+// Якоби до сходимости: невязка проверяется раз в sweeps проходов
+inline SolveStats poissonJacobi(const Poisson& A, const Field& f, Field& u, double epsilon, int maxIter,
+                                int sweeps, bool wavefront, double omega = 1.0) {
+    Field tmp = makeField(A);
+    Field r = makeField(A);
+    const double normF = norm(f);
+
+    SolveStats stats;
+    for (stats.iterations = 0; stats.iterations < maxIter; stats.iterations += sweeps) {
+        matvec(A, u, r);
+        double rr = 0.0;
+        #pragma omp parallel for num_threads(stencilOwners(A)) reduction(+:rr)
+        for (int i = 0; i < A.n; i++) {
+            double d = f[i] - r[i];
+            rr += d * d;
+        }
+        stats.error = std::sqrt(rr) / normF;
+        if (stats.error <= epsilon) {
+            break;
+        }
+        if (wavefront) {
+            jacobiWavefront(A, f, u, tmp, sweeps, omega);
+        } else {
+            jacobiSweeps(A, f, u, tmp, sweeps, omega);
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <algorithm>
+
+#include "linalg.h"
+
+// Симметричная матрица: хранится только нижний треугольник по строкам,
+// строка i занимает i + 1 элементов начиная с i (i + 1) / 2. Памяти вдвое меньше.
+struct PackedSymmetric {
+    int n = 0;
+    std::vector<double> a;
+
+    PackedSymmetric() = default;
+    explicit PackedSymmetric(int n) : n(n), a(static_cast<size_t>(n) * (n + 1) / 2) {}
+
+    static size_t rowStart(int i) { return static_cast<size_t>(i) * (i + 1) / 2; }
+
+    double at(int i, int j) const {
+        return (i >= j) ? a[rowStart(i) + j] : a[rowStart(j) + i];
+    }
+
+    // Частичные суммы потоков для matvec, чтобы не выделять их на каждой итерации
+    mutable std::vector<double> scratch;
+};
+
+// Матрица из задания сразу в упакованном виде
+inline void matrixInit(PackedSymmetric& A) {
+    const int N = A.n;
+    #pragma omp parallel for num_threads(threadsFor("symv")) schedule(dynamic, 64)
+    for (int i = 0; i < N; i++) {
+        double* row = A.a.data() + PackedSymmetric::rowStart(i);
+        for (int j = 0; j < i; j++) {
+            row[j] = 1.0;
+        }
+        row[i] = 2.0;
+    }
+}
+
+inline PackedSymmetric toPacked(const DenseMatrix& D) {
+    PackedSymmetric A(D.n);
+    #pragma omp parallel for num_threads(threadsFor("symv")) schedule(dynamic, 64)
+    for (int i = 0; i < D.n; i++) {
+        double* row = A.a.data() + PackedSymmetric::rowStart(i);
+        for (int j = 0; j <= i; j++) {
+            row[j] = D.at(i, j);
+        }
+    }
+    return A;
+}
+
+// Границы строк, при которых у потоков поровну элементов треугольника
+inline std::vector<int> triangularPartition(int n, int parts) {
+    std::vector<int> bounds(parts + 1, n);
+    bounds[0] = 0;
+    const double total = static_cast<double>(n) * (n + 1) / 2;
+    for (int p = 1; p < parts; p++) {
+        // i (i + 1) / 2 = total * p / parts
+        double target = total * p / parts;
+        int i = static_cast<int>(std::ceil((std::sqrt(1.0 + 8.0 * target) - 1.0) / 2.0));
+        bounds[p] = std::max(bounds[p - 1], std::min(i, n));
+    }
+    return bounds;
+}
+
+// y = A * x, каждый внедиагональный элемент читается один раз и идёт в обе строки:
+// y_i += a_ij x_j и y_j += a_ij x_i. Вклады в чужие строки поток копит в своём
+// буфере, затем буферы складываются.
+template <typename Vec>
+void matvec(const PackedSymmetric& A, const Vec& x, Vec& y) {
+    const int N = A.n;
+    const int threads = threadsFor("symv");
+    const std::vector<int> bounds = triangularPartition(N, threads);
+    A.scratch.resize(static_cast<size_t>(threads) * N);
+
+    #pragma omp parallel num_threads(threads)
+    {
+        for (int t = omp_get_thread_num(); t < threads; t += omp_get_num_threads()) {
+            double* part = A.scratch.data() + static_cast<size_t>(t) * N;
+            std::fill(part, part + bounds[t + 1], 0.0);
+            for (int i = bounds[t]; i < bounds[t + 1]; i++) {
+                const double* row = A.a.data() + PackedSymmetric::rowStart(i);
+                const double xi = x[i];
+                double sum = 0.0;
+                #pragma omp simd reduction(+:sum)
+                for (int j = 0; j < i; j++) {
+                    sum += row[j] * x[j];
+                    part[j] += row[j] * xi;
+                }
+                part[i] += sum + row[i] * xi;
+            }
+        }
+        #pragma omp barrier
+
+        // Поток t трогал только строки < bounds[t + 1]
+        #pragma omp for
+        for (int i = 0; i < N; i++) {
+            double sum = 0.0;
+            for (int t = 0; t < threads; t++) {
+                if (i < bounds[t + 1]) {
+                    sum += A.scratch[static_cast<size_t>(t) * N + i];
+                }
+            }
+            y[i] = sum;
+        }
+    }
+}
+
+template <typename Vec>
+double rowDot(const PackedSymmetric& A, int i, const Vec& x) {
+    const double* row = A.a.data() + PackedSymmetric::rowStart(i);
+    double sum = 0.0;
+    for (int j = 0; j <= i; j++) {
+        sum += row[j] * x[j];
+    }
+    for (int j = i + 1; j < A.n; j++) {
+        sum += A.a[PackedSymmetric::rowStart(j) + i] * x[j];
+    }
+    return sum;
+}
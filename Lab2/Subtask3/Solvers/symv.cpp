@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+#include "linalg.h"
+#include "symmetric.h"
+#include "precond.h"
+#include "krylov.h"
+
+// Запуск: ./symv [N]
+// Сравнивает умножение и решение для плотного и упакованного симметричного хранения.
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+
+    DenseMatrix D(N);
+    PackedSymmetric P(N);
+    std::vector<double> B(N);
+    matrixInit(D);
+    matrixInit(P);
+    vectorInit(B);
+
+    std::cout << "Dense: " << D.a.size() * sizeof(double) / 1e9 << " GB, packed: "
+              << P.a.size() * sizeof(double) / 1e9 << " GB" << std::endl;
+
+    double epsilon = 0.00001;
+    int maxIter = 100000;
+    std::vector<double> x(N), yd(N), yp(N);
+    for (int i = 0; i < N; i++) {
+        x[i] = std::sin(i);
+    }
+
+    std::ofstream file("symv.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    for (int i = 0; i < 20; i++) {
+        auto start = std::chrono::steady_clock::now();
+        matvec(D, x, yd);
+        std::chrono::duration<double> dense_seconds = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        matvec(P, x, yp);
+        std::chrono::duration<double> packed_seconds = std::chrono::steady_clock::now() - start;
+
+        double diff = 0.0;
+        for (int k = 0; k < N; k++) {
+            diff = std::max(diff, std::fabs(yd[k] - yp[k]));
+        }
+
+        std::vector<double> xprev(N, 0);
+        start = std::chrono::steady_clock::now();
+        SolveStats stats = pcg(P, B, xprev, IdentityPreconditioner(), epsilon, maxIter);
+        std::chrono::duration<double> solve_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Dense matvec: " << dense_seconds.count() << " s, packed matvec: "
+                  << packed_seconds.count() << " s, max diff: " << diff << std::endl;
+        std::cout << "Packed CG: " << stats.iterations << " iterations, " << solve_seconds.count()
+                  << " s, first elem: " << xprev[0] << std::endl;
+        file << dense_seconds.count() << "," << packed_seconds.count() << "," << solve_seconds.count() << std::endl;
+    }
+
+    file.close();
+    return 0;
+}
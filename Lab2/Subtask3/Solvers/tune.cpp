@@ -0,0 +1,128 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <algorithm>
+#include <functional>
+
+#include "linalg.h"
+#include "tuning.h"
+#include "sor.h"
+#include "stencil.h"
+#include "bandwidth.h"
+
+// Запуск: ./tune [N] [nx] [repeats]
+// Перебирает расписание, размер порции, число потоков и параметр блокировки для ядер
+// matvec (плотная N x N), sor (плотная N x N) и stencil (сетка nx^3) и записывает лучшие
+// значения в профиль машины ($SOLVERS_PROFILE или tuning.csv). Остальные программы
+// читают профиль при запуске. Перед этим измеряется точка насыщения памяти (запись
+// "bandwidth" для SOLVERS_THREADS=auto); потоки закрепляются как в этом режиме - scatter,
+// если PLACEMENT не задана.
+
+// Лучшее время из repeats запусков
+static double measure(const std::function<void()>& kernel, int repeats) {
+    double best = 1e300;
+    for (int r = 0; r < repeats; r++) {
+        const auto start = std::chrono::steady_clock::now();
+        kernel();
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+// Перебор кандидатов: каждый по очереди записывается в профиль, ядро читает его сам
+static void search(const std::string& name, long long n, const std::vector<KernelConfig>& candidates,
+                   const std::function<void()>& kernel, int repeats) {
+    TuningProfile& profile = TuningProfile::instance();
+    profile.set(name, n, KernelConfig());
+    kernel();  // прогрев
+    const double baseline = measure(kernel, repeats);
+
+    KernelConfig best;
+    double bestTime = baseline;
+    for (const KernelConfig& config : candidates) {
+        profile.set(name, n, config);
+        double t = measure(kernel, repeats);
+        if (t < bestTime) {
+            best = config;
+            bestTime = t;
+        }
+    }
+    profile.set(name, n, best, bestTime);
+
+    std::cout << name << " (n = " << n << "): " << scheduleName(best.schedule) << "," << best.chunk
+              << ", threads " << best.threads << ", block " << best.block
+              << " - " << bestTime << " s, default " << baseline << " s" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    const int N = (argc > 1) ? std::atoi(argv[1]) : 20000;
+    const int nx = (argc > 2) ? std::atoi(argv[2]) : 128;
+    const int repeats = (argc > 3) ? std::atoi(argv[3]) : 5;
+
+    const Topology& topology = Topology::instance();
+    if (!std::getenv("PLACEMENT")) {
+        pinOpenMPThreads(topology.placement(Placement::Scatter, static_cast<int>(topology.cpus.size())));
+    }
+    const BandwidthCurve curve = measureBandwidth(topology);
+    for (size_t k = 0; k < curve.threads.size(); k++) {
+        std::cout << "Bandwidth on " << curve.threads[k] << " threads: " << curve.gbs[k] << " GB/s" << std::endl;
+    }
+    KernelConfig bandwidth;
+    bandwidth.threads = curve.choose();
+    bandwidth.smt = curve.smt;
+    TuningProfile::instance().set("bandwidth", 0, bandwidth);
+    std::cout << "Saturation: " << curve.saturation << " threads, SMT " << (curve.smt ? "helps" : "does not help")
+              << std::endl;
+
+    std::vector<int> threads = curve.threads;
+    threads.push_back(curve.saturation);
+    threads.push_back(NUMBER_OF_THREADS);
+    std::sort(threads.begin(), threads.end());
+    threads.erase(std::unique(threads.begin(), threads.end()), threads.end());
+
+    std::cout << "Machine: " << TuningProfile::machine() << std::endl;
+    std::cout << "Profile: " << TuningProfile::instance().file() << std::endl;
+
+    DenseMatrix A(N);
+    std::vector<double> B(N), x(N, 1.0), y(N);
+    matrixInit(A);
+    vectorInit(B);
+
+    std::vector<KernelConfig> candidates;
+    for (omp_sched_t kind : {omp_sched_static, omp_sched_dynamic, omp_sched_guided}) {
+        for (int chunk : {0, 1, 16, 64, 256, 1024}) {
+            for (int t : threads) {
+                candidates.push_back({kind, chunk, t, 0});
+            }
+        }
+    }
+    search("matvec", N, candidates, [&]() { matvec(A, x, y); }, repeats);
+
+    candidates.clear();
+    for (int panel : {64, 128, 256, 512, 1024}) {
+        for (int t : threads) {
+            candidates.push_back({omp_sched_static, 0, t, panel});
+        }
+    }
+    search("sor", N, candidates, [&]() { sorSweep(A, B, x, 1.0); }, repeats);
+
+    Poisson P(nx, nx, nx);
+    Field f = makeField(P, 1.0), u = makeField(P), tmp = makeField(P);
+    candidates.clear();
+    for (int blockY : {4, 8, 16, 32, 64}) {
+        for (int t : threads) {
+            candidates.push_back({omp_sched_static, 0, t, blockY});
+        }
+    }
+    search("stencil", P.n, candidates, [&]() { jacobiSweeps(P, f, u, tmp, 1); }, repeats);
+
+    if (!TuningProfile::instance().save()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
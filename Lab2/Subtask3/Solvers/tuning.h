@@ -0,0 +1,234 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <utility>
+
+#include <omp.h>
+#include <unistd.h>
+
+#include "topology.h"
+
+#ifndef NUMBER_OF_THREADS
+    #define NUMBER_OF_THREADS 20
+#endif
+
+// Параметры запуска одного ядра: расписание omp for, число потоков и параметр
+// блокировки (blockY для сетки, ширина панели для SOR). 0 - значение по умолчанию.
+// smt - занимать ли SMT-соседей (false - tuned() даёт потоков не больше, чем ядер).
+struct KernelConfig {
+    omp_sched_t schedule = omp_sched_static;
+    int chunk = 0;
+    int threads = NUMBER_OF_THREADS;
+    int block = 0;
+    bool smt = true;
+
+    // Выставить расписание для циклов с schedule(runtime)
+    void apply() const { omp_set_schedule(schedule, chunk); }
+};
+
+inline const char* scheduleName(omp_sched_t kind) {
+    switch (kind) {
+        case omp_sched_dynamic: return "dynamic";
+        case omp_sched_guided: return "guided";
+        case omp_sched_auto: return "auto";
+        default: return "static";
+    }
+}
+
+inline omp_sched_t scheduleFromName(const std::string& name) {
+    if (name == "dynamic") return omp_sched_dynamic;
+    if (name == "guided") return omp_sched_guided;
+    if (name == "auto") return omp_sched_auto;
+    return omp_sched_static;
+}
+
+// Профиль машины: лучшие параметры ядер по размерам задачи. Хранится в CSV
+// machine,kernel,n,schedule,chunk,threads,block,seconds,smt; записи других машин
+// сохраняются при перезаписи файла. Профиль читается один раз при первом обращении
+// из $SOLVERS_PROFILE или tuning.csv в текущем каталоге, нет файла - параметры по умолчанию.
+class TuningProfile {
+public:
+    struct Entry {
+        std::string machine;
+        std::string kernel;
+        long long n = 0;
+        KernelConfig config;
+        double seconds = 0.0;
+    };
+
+    static TuningProfile& instance() {
+        static TuningProfile profile(defaultPath());
+        return profile;
+    }
+
+    static std::string defaultPath() {
+        const char* env = std::getenv("SOLVERS_PROFILE");
+        return env ? env : "tuning.csv";
+    }
+
+    // Имя узла, число процессоров и модель процессора
+    static std::string machine() {
+        char host[256] = {};
+        gethostname(host, sizeof(host) - 1);
+        std::string model;
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line)) {
+            if (line.compare(0, 10, "model name") == 0) {
+                model = line.substr(line.find(':') + 2);
+                break;
+            }
+        }
+        std::string id = std::string(host) + "/" + std::to_string(omp_get_num_procs()) + "/" + model;
+        std::replace(id.begin(), id.end(), ',', ' ');
+        return id;
+    }
+
+    explicit TuningProfile(std::string path) : path(std::move(path)), self(machine()) {
+        load();
+    }
+
+    const std::string& file() const { return path; }
+
+    // Параметры ядра для этой машины и ближайшего (в логарифмической шкале) размера;
+    // ядра без настройки получают fallback()
+    KernelConfig get(const std::string& kernel, long long n) const {
+        auto it = table.find(kernel);
+        if (it == table.end() || it->second.empty()) {
+            return defaults;
+        }
+        const Entry* best = nullptr;
+        double distance = 0.0;
+        for (const Entry& e : it->second) {
+            double d = std::fabs(std::log(static_cast<double>(std::max(n, 1LL)) / std::max(e.n, 1LL)));
+            if (!best || d < distance) {
+                best = &e;
+                distance = d;
+            }
+        }
+        return best->config;
+    }
+
+    // Точная запись для размера n
+    bool find(const std::string& kernel, long long n, KernelConfig& config) const {
+        auto it = table.find(kernel);
+        if (it != table.end()) {
+            for (const Entry& e : it->second) {
+                if (e.n == n) {
+                    config = e.config;
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    const KernelConfig& fallback() const { return defaults; }
+    void setFallback(const KernelConfig& config) { defaults = config; }
+
+    void set(const std::string& kernel, long long n, const KernelConfig& config, double seconds = 0.0) {
+        std::vector<Entry>& entries = table[kernel];
+        for (Entry& e : entries) {
+            if (e.n == n) {
+                e.config = config;
+                e.seconds = seconds;
+                return;
+            }
+        }
+        entries.push_back({self, kernel, n, config, seconds});
+    }
+
+    // Убрать настройку размера n (например, перед новым поиском)
+    void erase(const std::string& kernel, long long n) {
+        std::vector<Entry>& entries = table[kernel];
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [n](const Entry& e) { return e.n == n; }),
+                      entries.end());
+    }
+
+    bool save() const {
+        std::ofstream out(path);
+        if (!out.is_open()) {
+            return false;
+        }
+        out << "Machine,Kernel,N,Schedule,Chunk,Threads,Block,Time (s),SMT" << std::endl;
+        for (const Entry& e : others) {
+            write(out, e);
+        }
+        for (const auto& kernel : table) {
+            for (const Entry& e : kernel.second) {
+                write(out, e);
+            }
+        }
+        return true;
+    }
+
+private:
+    void load() {
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);  // заголовок
+        while (std::getline(in, line)) {
+            std::vector<std::string> fields;
+            std::stringstream ss(line);
+            std::string field;
+            while (std::getline(ss, field, ',')) {
+                fields.push_back(field);
+            }
+            if (fields.size() < 7) {
+                continue;
+            }
+            Entry e;
+            e.machine = fields[0];
+            e.kernel = fields[1];
+            e.n = std::atoll(fields[2].c_str());
+            e.config.schedule = scheduleFromName(fields[3]);
+            e.config.chunk = std::atoi(fields[4].c_str());
+            e.config.threads = std::max(1, std::atoi(fields[5].c_str()));
+            e.config.block = std::atoi(fields[6].c_str());
+            e.seconds = (fields.size() > 7) ? std::atof(fields[7].c_str()) : 0.0;
+            e.config.smt = (fields.size() > 8) ? std::atoi(fields[8].c_str()) != 0 : true;
+            if (e.machine == self) {
+                table[e.kernel].push_back(e);
+            } else {
+                others.push_back(e);
+            }
+        }
+    }
+
+    static void write(std::ofstream& out, const Entry& e) {
+        out << e.machine << "," << e.kernel << "," << e.n << "," << scheduleName(e.config.schedule) << ","
+            << e.config.chunk << "," << e.config.threads << "," << e.config.block << "," << e.seconds
+            << "," << e.config.smt << std::endl;
+    }
+
+    std::string path;
+    std::string self;
+    std::map<std::string, std::vector<Entry>> table;
+    std::vector<Entry> others;
+    KernelConfig defaults;
+};
+
+// Параметры ядра из профиля; при smt = false потоков не больше, чем ядер
+inline KernelConfig tuned(const std::string& kernel, long long n) {
+    KernelConfig config = TuningProfile::instance().get(kernel, n);
+    if (!config.smt) {
+        config.threads = std::min(config.threads, std::max(1, Topology::instance().cores()));
+    }
+    return config;
+}
+
+// Число потоков для ядра, упирающегося в память (tuned(), с учётом smt): запись ядра
+// в профиле, если она есть, иначе fallback профиля - в режиме SOLVERS_THREADS=auto это точка насыщения памяти
+// (bandwidth.h), без него NUMBER_OF_THREADS. Через эту функцию число потоков берут все
+// такие ядра: векторные операции, невязки, разреженные и упакованные умножения,
+// предобуславливатели и блочные операции.
+inline int threadsFor(const std::string& kernel, long long n = 0) {
+    return tuned(kernel, n).threads;
+}
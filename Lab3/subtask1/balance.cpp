@@ -0,0 +1,55 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+
+#include "thread_pool.h"
+#include "work_stealing.h"
+
+// Запуск: ./balance [threads] [size]
+// Неравномерная нагрузка: умножение нижнетреугольной матрицы на вектор, строка i стоит i операций.
+// Равные куски строк (ThreadPool) против захвата работы (WorkStealingPool).
+int main(int argc, char** argv) {
+    const int threads = (argc > 1) ? std::atoi(argv[1]) : 40;
+    const int size = (argc > 2) ? std::atoi(argv[2]) : 20000;
+
+    std::vector<double> matrix(static_cast<size_t>(size) * size, 1.0);
+    std::vector<double> vector(size, 1.0);
+    std::vector<double> result(size, 0.0);
+
+    auto triangular = [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+            double sum = 0.0;
+            for (size_t j = 0; j <= i; ++j) {
+                sum += matrix[i * size + j] * vector[j];
+            }
+            result[i] = sum;
+        }
+    };
+
+    std::ofstream file("balance.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    ThreadPool pool(threads);
+    WorkStealingPool stealing(threads);
+    for (int i = 0; i < 20; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        pool.parallel_for(0, size, triangular);
+        const std::chrono::duration<double> static_seconds = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        stealing.parallel_for(0, size, 16, triangular);
+        const std::chrono::duration<double> stealing_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Static ranges: " << static_seconds.count() << " seconds, work stealing: "
+                  << stealing_seconds.count() << " seconds. Last elem: " << result[size - 1] << std::endl;
+        file << threads << "," << static_seconds.count() << "," << stealing_seconds.count() << std::endl;
+    }
+    file.close();
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#include <omp.h>
+
+#include "barrier.h"
+#include "topology.h"
+
+// Запуск: ./barrier [threads] [waits]
+// Стоимость барьера на threads потоках, среднее по waits проходам: общий счётчик на всю
+// команду, иерархический барьер (common/barrier.h) и omp barrier для сравнения.
+// PLACEMENT закрепляет потоки, и тогда дерево барьера повторяет ядра и разъёмы.
+
+// Плоский барьер: один счётчик и одно поколение на всех, ожидание - как в иерархическом
+struct FlatBarrier {
+    explicit FlatBarrier(int threads)
+        : threads(threads), spinLimit(threads <= static_cast<int>(std::thread::hardware_concurrency())
+                                          ? HierarchicalBarrier::SPIN_ITERATIONS
+                                          : HierarchicalBarrier::OVERSUBSCRIBED_SPIN_ITERATIONS) {}
+
+    void wait(int) {
+        const int current = generation.load(std::memory_order_acquire);
+        if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == threads) {
+            arrived.store(0, std::memory_order_relaxed);
+            generation.fetch_add(1);
+            if (sleeping.load() > 0) {
+                futex::wakeAll(generation);
+            }
+            return;
+        }
+        for (int spin = 0; spin < spinLimit; ++spin) {
+            if (generation.load(std::memory_order_acquire) != current) {
+                return;
+            }
+            cpuRelax();
+        }
+        sleeping.fetch_add(1);
+        while (generation.load() == current) {
+            futex::wait(generation, current);
+        }
+        sleeping.fetch_sub(1);
+    }
+
+    const int threads;
+    const int spinLimit;
+    alignas(64) std::atomic<int> arrived{0};
+    alignas(64) std::atomic<int> generation{0};
+    std::atomic<int> sleeping{0};
+};
+
+// Среднее время одного прохода барьера командой из threads потоков
+template <typename Barrier>
+double measure(Barrier& barrier, int threads, int waits, const std::vector<int>& cpus) {
+    double seconds = 0.0;
+    auto body = [&](int self) {
+        if (!cpus.empty()) {
+            pinCurrentThread(cpus[self]);
+        }
+        barrier.wait(self);  // все потоки запущены
+        auto start = std::chrono::steady_clock::now();
+        for (int w = 0; w < waits; ++w) {
+            barrier.wait(self);
+        }
+        if (self == 0) {
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+    };
+    std::vector<std::thread> team;
+    for (int t = 1; t < threads; ++t) {
+        team.emplace_back(body, t);
+    }
+    body(0);
+    for (auto& t : team) {
+        t.join();
+    }
+    return seconds / waits;
+}
+
+int main(int argc, char** argv) {
+    const int threads = (argc > 1) ? std::atoi(argv[1]) : 80;
+    const int waits = (argc > 2) ? std::atoi(argv[2]) : 100000;
+    const std::vector<int> cpus = placementFromEnv(threads);
+
+    FlatBarrier flat(threads);
+    const double flat_seconds = measure(flat, threads, waits, cpus);
+
+    HierarchicalBarrier tree(threads, cpus);
+    const double tree_seconds = measure(tree, threads, waits, cpus);
+
+    double omp_seconds = 0.0;
+    #pragma omp parallel num_threads(threads)
+    {
+        #pragma omp barrier
+        auto start = std::chrono::steady_clock::now();
+        for (int w = 0; w < waits; ++w) {
+            #pragma omp barrier
+        }
+        if (omp_get_thread_num() == 0) {
+            omp_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / waits;
+        }
+    }
+
+    std::cout << "Flat barrier: " << flat_seconds * 1e6 << " us per wait." << std::endl;
+    std::cout << "Hierarchical barrier (depth " << tree.depth(0) << "): " << tree_seconds * 1e6 << " us per wait."
+              << std::endl;
+    std::cout << "omp barrier: " << omp_seconds * 1e6 << " us per wait." << std::endl;
+
+    std::ofstream file("barrier.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    file << threads << "," << flat_seconds << "," << tree_seconds << "," << omp_seconds << std::endl;
+    file.close();
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <algorithm>
+
+#include "task.h"
+#include "work_stealing.h"
+
+// Запуск: ./coroutines [threads] [size] [rows per task]
+// Треугольная матрица на вектор, как в balance: каждая порция строк - отдельная задача-корутина
+// (task.h), все ждутся через when_all. Для сравнения - WorkStealingPool::parallel_for с тем же зерном.
+// Потом - сумма по многим мелким задачам, которые ждут друг друга, не блокируя потоки.
+
+task<double> rows(TaskPool& pool, const std::vector<double>& matrix, const std::vector<double>& vector,
+                  std::vector<double>& result, size_t size, size_t start, size_t end) {
+    co_await pool.schedule();
+    double last = 0.0;
+    for (size_t i = start; i < end; ++i) {
+        double sum = 0.0;
+        for (size_t j = 0; j <= i; ++j) {
+            sum += matrix[i * size + j] * vector[j];
+        }
+        result[i] = sum;
+        last = sum;
+    }
+    co_return last;
+}
+
+task<double> multiply(TaskPool& pool, const std::vector<double>& matrix, const std::vector<double>& vector,
+                      std::vector<double>& result, size_t size, size_t grain) {
+    std::vector<task<double>> parts;
+    for (size_t start = 0; start < size; start += grain) {
+        parts.push_back(rows(pool, matrix, vector, result, size, start, std::min(size, start + grain)));
+    }
+    std::vector<double> last = co_await when_all(std::move(parts));
+    co_return last.back();
+}
+
+// Дерево задач: сумма [first, last) делится пополам, пока не останется leaf чисел
+task<long long> treeSum(TaskPool& pool, long long first, long long last, long long leaf) {
+    co_await pool.schedule();
+    if (last - first <= leaf) {
+        long long sum = 0;
+        for (long long i = first; i < last; ++i) {
+            sum += i;
+        }
+        co_return sum;
+    }
+    const long long mid = first + (last - first) / 2;
+    std::vector<task<long long>> halves;
+    halves.push_back(treeSum(pool, first, mid, leaf));
+    halves.push_back(treeSum(pool, mid, last, leaf));
+    std::vector<long long> sums = co_await when_all(std::move(halves));
+    co_return sums[0] + sums[1];
+}
+
+int main(int argc, char** argv) {
+    const int threads = (argc > 1) ? std::atoi(argv[1]) : 40;
+    const size_t size = (argc > 2) ? std::atoi(argv[2]) : 20000;
+    const size_t grain = (argc > 3) ? std::atoi(argv[3]) : 16;
+
+    std::vector<double> matrix(size * size, 1.0);
+    std::vector<double> vector(size, 1.0);
+    std::vector<double> result(size, 0.0);
+
+    auto triangular = [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+            double sum = 0.0;
+            for (size_t j = 0; j <= i; ++j) {
+                sum += matrix[i * size + j] * vector[j];
+            }
+            result[i] = sum;
+        }
+    };
+
+    std::ofstream file("coroutines.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+
+    TaskPool pool(threads);
+    WorkStealingPool stealing(threads);
+    const long long leaves = 1 << 16;
+    for (int i = 0; i < 20; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        const double last = sync_wait(multiply(pool, matrix, vector, result, size, grain));
+        const std::chrono::duration<double> task_seconds = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        stealing.parallel_for(0, size, grain, triangular);
+        const std::chrono::duration<double> stealing_seconds = std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        const long long sum = sync_wait(treeSum(pool, 0, leaves * 64, 64));
+        const std::chrono::duration<double> tree_seconds = std::chrono::steady_clock::now() - start;
+
+        std::cout << "Tasks (" << (size + grain - 1) / grain << "): " << task_seconds.count()
+                  << " seconds, work stealing: " << stealing_seconds.count() << " seconds. Last elem: " << last
+                  << std::endl;
+        std::cout << "Task tree (" << 2 * leaves - 1 << " tasks): " << tree_seconds.count()
+                  << " seconds, sum: " << sum << std::endl;
+        file << threads << "," << task_seconds.count() << "," << stealing_seconds.count() << ","
+             << tree_seconds.count() << std::endl;
+    }
+    file.close();
+
+    return 0;
+}
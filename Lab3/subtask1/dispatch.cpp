@@ -0,0 +1,72 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <thread>
+#include <omp.h>
+
+#include "thread_pool.h"
+
+// Запуск: ./dispatch [threads] [jobs]
+// Задержка раздачи задания потокам: пустое задание на threads потоков, среднее по jobs запускам.
+// std::thread создаёт и присоединяет потоки на каждое задание, как раньше multiplication.cpp,
+// пул раздаёт задание уже работающим потокам, OpenMP - для сравнения.
+int main(int argc, char** argv) {
+    const int threads = (argc > 1) ? std::atoi(argv[1]) : 40;
+    const int jobs = (argc > 2) ? std::atoi(argv[2]) : 10000;
+
+    std::vector<double> sink(threads * 8, 0.0);
+    auto job = [&](size_t start, size_t end) {
+        for (size_t i = start; i < end; ++i) {
+            sink[i * 8] += 1.0;
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (int j = 0; j < jobs; ++j) {
+        std::vector<std::thread> team;
+        for (int t = 0; t < threads; ++t) {
+            team.emplace_back(job, t, t + 1);
+        }
+        for (auto& t : team) {
+            t.join();
+        }
+    }
+    std::chrono::duration<double> spawn_seconds = std::chrono::steady_clock::now() - start;
+
+    double pool_seconds;
+    {
+        ThreadPool pool(threads);
+        pool.parallel_for(0, threads, job);  // прогрев
+        start = std::chrono::steady_clock::now();
+        for (int j = 0; j < jobs; ++j) {
+            pool.parallel_for(0, threads, job);
+        }
+        pool_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    start = std::chrono::steady_clock::now();
+    for (int j = 0; j < jobs; ++j) {
+        #pragma omp parallel for num_threads(threads) schedule(static)
+        for (int t = 0; t < threads; ++t) {
+            job(t, t + 1);
+        }
+    }
+    std::chrono::duration<double> omp_seconds = std::chrono::steady_clock::now() - start;
+
+    std::cout << "std::thread create/join: " << spawn_seconds.count() / jobs * 1e6 << " us per job." << std::endl;
+    std::cout << "ThreadPool::parallel_for: " << pool_seconds / jobs * 1e6 << " us per job." << std::endl;
+    std::cout << "omp parallel for: " << omp_seconds.count() / jobs * 1e6 << " us per job." << std::endl;
+
+    std::ofstream file("dispatch.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    file << threads << "," << spawn_seconds.count() / jobs << "," << pool_seconds / jobs << ","
+         << omp_seconds.count() / jobs << std::endl;
+    file.close();
+
+    return 0;
+}
@@ -9,6 +9,8 @@
 #include <thread>
 #include <mutex>
 
+#include "work_stealing.h"
+
 #define SIZE 40000
 #define NUM_THREADS 40
 
@@ -52,42 +54,24 @@ int main() {
 
     std::minstd_rand gen(std::rand());
 
-    std::vector<std::thread> threads;
-    int chunk_size = SIZE / NUM_THREADS;
-    for (int i = 0; i < NUM_THREADS; ++i) {
-        int start = i * chunk_size;
-        int end = (i == NUM_THREADS - 1) ? SIZE : start + chunk_size;
-        threads.emplace_back(initialize_vector, std::ref(vector), start, end, std::ref(gen));
-    }
-    for (auto& t : threads) {
-        t.join();
-    }
-    threads.clear();
- 
-    chunk_size = (SIZE * SIZE) / NUM_THREADS;
-    for (int i = 0; i < NUM_THREADS; ++i) {
-        int start = i * chunk_size;
-        int end = (i == NUM_THREADS - 1) ? SIZE * SIZE : start + chunk_size;
-        threads.emplace_back(initialize_matrix, std::ref(matrix), start, end, std::ref(gen));
-    }
-    for (auto& t : threads) {
-        t.join();
-    }
-    threads.clear();
+    // Потоки создаются один раз, дальше только раздаются задания. Строки раздаются
+    // кусками по 64 с захватом работы, так что отставший поток не держит весь join.
+    // PLACEMENT=compact|scatter|one-per-core|node-local закрепляет потоки (topology.h).
+    WorkStealingPool pool(NUM_THREADS, placementFromEnv(NUM_THREADS));
+
+    pool.parallel_for(0, SIZE, [&](size_t start, size_t end) {
+        initialize_vector(vector, start, end, gen);
+    });
+    pool.parallel_for(0, static_cast<size_t>(SIZE) * SIZE, [&](size_t start, size_t end) {
+        initialize_matrix(matrix, start, end, gen);
+    });
 
     for (int i = 0; i < 20; ++i) {
         const auto start = std::chrono::steady_clock::now();
 
-        chunk_size = SIZE / NUM_THREADS;
-        for (int i = 0; i < NUM_THREADS; ++i) {
-            int start_idx = i * chunk_size;
-            int end_idx = (i == NUM_THREADS - 1) ? SIZE : start_idx + chunk_size;
-            threads.emplace_back(multiply_part, std::ref(vector), std::ref(matrix), std::ref(result), start_idx, end_idx);
-        }
-        for (auto& t : threads) {
-            t.join();
-        }
-        threads.clear();
+        pool.parallel_for(0, SIZE, 64, [&](size_t start_idx, size_t end_idx) {
+            multiply_part(vector, matrix, result, start_idx, end_idx);
+        });
 
         const auto end = std::chrono::steady_clock::now();
         const std::chrono::duration<double> elapsed_seconds = end - start;
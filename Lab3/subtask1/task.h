@@ -0,0 +1,433 @@
+#pragma once
+
+#include <coroutine>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <optional>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include "futex.h"
+#include "topology.h"
+#include "work_stealing.h"
+
+/*
+Задачи на корутинах C++20 поверх пула с захватом работы.
+
+task<T> - ленивая корутина: начинает выполняться, когда её ждут (co_await или sync_wait),
+а по завершении сразу передаёт управление тому, кто ждал. В другой поток задача
+переходит сама: co_await pool.schedule() кладёт её в дек текущего рабочего потока
+(или в общую очередь, если ставит чужой поток), и её выполнит тот, кто возьмёт первым.
+when_all(tasks) запускает все задачи и ждёт их без блокировки потока: продолжает тот,
+кто завершил последнюю. sync_wait(task) - мост из обычного кода: блокирует вызывающий поток.
+
+Пока задача ждёт, поток занят другими задачами, поэтому десятки тысяч мелких задач
+уживаются на стольких потоках, сколько ядер.
+*/
+
+class TaskPool;
+
+template <typename T = void>
+class task;
+
+// Общее у обещаний всех task<T>: ленивый старт, продолжение, исключение
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation = std::noop_coroutine();
+    std::exception_ptr error;
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+            return h.promise().continuation;
+        }
+
+        void await_resume() noexcept {}
+    };
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() { error = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+
+    task<T> get_return_object();
+    void return_value(T v) { value.emplace(std::move(v)); }
+
+    T result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    task<void> get_return_object();
+    void return_void() {}
+
+    void result() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+
+template <typename T>
+class task {
+public:
+    using promise_type = TaskPromise<T>;
+
+    task() = default;
+    explicit task(std::coroutine_handle<promise_type> h) : handle(h) {}
+    task(task&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    task& operator=(task&& other) noexcept {
+        if (this != &other) {
+            if (handle) {
+                handle.destroy();
+            }
+            handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    bool done() const { return !handle || handle.done(); }
+
+    // co_await task: запустить и получить результат (или исключение)
+    auto operator co_await() & noexcept { return Awaiter<false>{handle}; }
+    auto operator co_await() && noexcept { return Awaiter<false>{handle}; }
+
+    // Дождаться завершения, не забирая результат (when_all, sync_wait)
+    auto ready() noexcept { return Awaiter<true>{handle}; }
+
+    // Результат завершённой задачи
+    T result() { return handle.promise().result(); }
+
+private:
+    template <bool onlyReady>
+    struct Awaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept { return !handle || handle.done(); }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> waiter) noexcept {
+            handle.promise().continuation = waiter;
+            return handle;
+        }
+
+        decltype(auto) await_resume() {
+            if constexpr (!onlyReady) {
+                return handle.promise().result();
+            }
+        }
+    };
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+template <typename T>
+task<T> TaskPromise<T>::get_return_object() {
+    return task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline task<void> TaskPromise<void>::get_return_object() {
+    return task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+// Корутина без владельца: стартует сразу, в конце уничтожает себя и передаёт
+// управление next (если задан). Служебная - для when_all и sync_wait.
+struct DetachedTask {
+    struct promise_type {
+        std::coroutine_handle<> next = std::noop_coroutine();
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                std::coroutine_handle<> next = h.promise().next;
+                h.destroy();
+                return next;
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        DetachedTask get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    // co_await DetachedTask::ContinueWith{h}: по завершении корутины передать управление h
+    struct ContinueWith {
+        std::coroutine_handle<> next;
+
+        bool await_ready() noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+            h.promise().next = next;
+            return false;
+        }
+
+        void await_resume() noexcept {}
+    };
+};
+
+/*
+Пул для задач: у каждого рабочего потока свой дек Чейза-Лева дескрипторов корутин,
+свободный поток ворует сначала у потоков своего разъёма, потом у остальных; задачи от
+потоков не из пула попадают в общую очередь под мьютексом. Нечего делать - поток
+крутится, потом спит в futex; schedule() будит одного спящего.
+cpus - необязательное размещение, как у ThreadPool.
+*/
+class TaskPool {
+public:
+    explicit TaskPool(int threads, std::vector<int> cpus = {})
+        : spinLimit(threads <= static_cast<int>(std::thread::hardware_concurrency())
+                        ? ThreadPool::SPIN_ITERATIONS : ThreadPool::OVERSUBSCRIBED_SPIN_ITERATIONS),
+          cpus(std::move(cpus)), packages(threads) {
+        for (int t = 0; t < threads; ++t) {
+            deques.push_back(std::make_unique<ChaseLevDeque<std::coroutine_handle<>>>());
+            packages[t] = this->cpus.empty() ? 0 : packageOf(this->cpus[t % this->cpus.size()]);
+        }
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back(&TaskPool::run, this, t);
+        }
+    }
+
+    // Задачи, которые ещё лежат в очередях, не выполняются: дождитесь их через sync_wait
+    ~TaskPool() {
+        stop.store(true);
+        signal.fetch_add(1);
+        futex::wakeAll(signal);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    TaskPool(const TaskPool&) = delete;
+    TaskPool& operator=(const TaskPool&) = delete;
+
+    int size() const { return static_cast<int>(deques.size()); }
+
+    // co_await pool.schedule(): продолжить корутину на одном из потоков пула
+    auto schedule() noexcept {
+        struct Awaiter {
+            TaskPool& pool;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { pool.post(h); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    void post(std::coroutine_handle<> h) {
+        if (current.pool != this || !deques[current.index]->push(h)) {
+            std::lock_guard<std::mutex> lock(injectedMutex);
+            injected.push_back(h);
+            injectedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        // Спящий либо увидит задачу при повторной проверке, либо будет разбужен
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed) > 0) {
+            signal.fetch_add(1);
+            futex::wakeOne(signal);
+        }
+    }
+
+private:
+    // Поток пула и его номер; у чужих потоков pool == nullptr (thread_local обнуляется)
+    struct Worker {
+        TaskPool* pool;
+        int index;
+    };
+
+    static int packageOf(int cpu) {
+        const CpuInfo* c = Topology::instance().cpu(cpu);
+        return c ? c->package : 0;
+    }
+
+    bool takeInjected(std::coroutine_handle<>& h) {
+        if (injectedCount.load(std::memory_order_relaxed) == 0) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(injectedMutex);
+        if (injected.empty()) {
+            return false;
+        }
+        h = injected.front();
+        injected.pop_front();
+        injectedCount.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Жертвы: сначала потоки того же разъёма, потом остальные, с случайного места
+    bool steal(int self, std::minstd_rand& gen, std::coroutine_handle<>& h) {
+        const int n = size();
+        const int offset = static_cast<int>(gen() % n);
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int k = 0; k < n; ++k) {
+                int victim = (offset + k) % n;
+                if (victim == self || (packages[victim] == packages[self]) != (pass == 0)) {
+                    continue;
+                }
+                if (deques[victim]->steal(h)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool anyWork() const {
+        if (injectedCount.load(std::memory_order_relaxed) > 0) {
+            return true;
+        }
+        for (const auto& deque : deques) {
+            if (!deque->empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(int self) {
+        if (!cpus.empty()) {
+            pinCurrentThread(cpus[self % cpus.size()]);
+        }
+        current = {this, self};
+        std::minstd_rand gen(self + 1);
+        std::coroutine_handle<> h;
+        int idle = 0;
+        while (!stop.load(std::memory_order_acquire)) {
+            if (deques[self]->pop(h) || takeInjected(h) || steal(self, gen, h)) {
+                h.resume();
+                idle = 0;
+            } else if (++idle < spinLimit) {
+                cpuRelax();
+            } else {
+                const int seen = signal.load();
+                sleeping.fetch_add(1);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!anyWork() && !stop.load()) {
+                    futex::wait(signal, seen);
+                }
+                sleeping.fetch_sub(1);
+                idle = 0;
+            }
+        }
+        current = Worker{nullptr, 0};
+    }
+
+    static inline thread_local Worker current;
+
+    const int spinLimit;
+    const std::vector<int> cpus;
+    std::vector<int> packages;  // разъём каждого потока (по размещению), подсказка для воров
+    std::vector<std::unique_ptr<ChaseLevDeque<std::coroutine_handle<>>>> deques;
+    std::vector<std::thread> workers;
+
+    std::mutex injectedMutex;
+    std::deque<std::coroutine_handle<>> injected;
+    std::atomic<size_t> injectedCount{0};
+
+    alignas(64) std::atomic<int> signal{0};
+    alignas(64) std::atomic<int> sleeping{0};
+    std::atomic<bool> stop{false};
+};
+
+// Счётчик when_all: задачи плюс сам ожидающий; кто обнулит - продолжает ожидающего
+struct WhenAllCounter {
+    std::atomic<size_t> count;
+    std::coroutine_handle<> waiter;
+};
+
+template <typename T>
+DetachedTask countDown(task<T>& t, WhenAllCounter& counter) {
+    co_await t.ready();
+    if (counter.count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        co_await DetachedTask::ContinueWith{counter.waiter};
+    }
+}
+
+template <typename T>
+struct WhenAllAwaiter {
+    std::vector<task<T>>& tasks;
+    WhenAllCounter counter{};
+
+    bool await_ready() const noexcept { return tasks.empty(); }
+
+    bool await_suspend(std::coroutine_handle<> waiter) {
+        counter.count.store(tasks.size() + 1, std::memory_order_relaxed);
+        counter.waiter = waiter;
+        for (task<T>& t : tasks) {
+            countDown(t, counter);
+        }
+        // Все уже завершились - не засыпать
+        return counter.count.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void await_resume() const noexcept {}
+};
+
+// Дождаться всех задач; результаты - в порядке задач, первое исключение пробрасывается
+template <typename T>
+task<std::vector<T>> when_all(std::vector<task<T>> tasks) {
+    co_await WhenAllAwaiter<T>{tasks};
+    std::vector<T> results;
+    results.reserve(tasks.size());
+    for (task<T>& t : tasks) {
+        results.push_back(t.result());
+    }
+    co_return results;
+}
+
+inline task<void> when_all(std::vector<task<void>> tasks) {
+    co_await WhenAllAwaiter<void>{tasks};
+    for (task<void>& t : tasks) {
+        t.result();
+    }
+}
+
+// Флаг в куче: будящий держит его, даже если ожидающий уже проснулся и вернулся
+template <typename T>
+DetachedTask signalWhenReady(task<T>& t, std::shared_ptr<std::atomic<int>> done) {
+    co_await t.ready();
+    done->store(1);
+    futex::wakeAll(*done);
+}
+
+// Выполнить задачу из обычного кода (не из потока пула): вызывающий поток спит,
+// пока она не завершится
+template <typename T>
+T sync_wait(task<T> t) {
+    auto done = std::make_shared<std::atomic<int>>(0);
+    signalWhenReady(t, done);
+    while (done->load() == 0) {
+        futex::wait(*done, 0);
+    }
+    return t.result();
+}
@@ -0,0 +1,35 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+#include "topology.h"
+
+// Запуск: ./topology [threads]
+// Печатает топологию машины и процессоры, которые получат threads потоков при каждой политике.
+int main(int argc, char** argv) {
+    const Topology& topology = Topology::instance();
+    const int threads = (argc > 1) ? std::atoi(argv[1]) : static_cast<int>(topology.cpus.size());
+
+    std::cout << "CPUs: " << topology.cpus.size() << ", cores: " << topology.cores()
+              << ", packages: " << topology.packages() << ", NUMA nodes: " << topology.nodes()
+              << ", threads per core: " << topology.threadsPerCore() << std::endl;
+    for (const CpuInfo& cpu : topology.cpus) {
+        std::cout << "cpu" << cpu.id << ": package " << cpu.package << ", node " << cpu.node
+                  << ", core " << cpu.core << ", SMT " << cpu.smt << std::endl;
+    }
+    for (const CacheInfo& cache : topology.caches) {
+        std::cout << "L" << cache.level << " " << cache.type << ": " << cache.size / 1024 << " KB, line "
+                  << cache.lineSize << ", shared by " << cache.cpus.size() << " CPUs" << std::endl;
+    }
+
+    for (const std::string name : {"compact", "scatter", "one-per-core", "node-local"}) {
+        std::cout << name << ":";
+        for (int cpu : topology.placement(placementFromName(name), threads)) {
+            std::cout << " " << cpu;
+        }
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
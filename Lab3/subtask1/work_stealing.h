@@ -0,0 +1,334 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <exception>
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include "thread_pool.h"
+
+// Полуинтервал индексов
+struct Range {
+    size_t begin = 0;
+    size_t end = 0;
+
+    size_t size() const { return end - begin; }
+};
+
+/*
+Дек Чейза-Лева: владелец кладёт и берёт снизу (push/pop) без блокировок, воры забирают
+сверху (steal) одним CAS. Ёмкость фиксирована: при двоичном делении в деке лежит не больше
+log2(n / grain) кусков, а если места нет, владелец просто выполняет кусок сам.
+T - тривиально копируемый элемент (Range, дескриптор корутины); в ячейке он лежит
+машинными словами, каждое - атомарное, чтобы чтение вором во время записи не было гонкой.
+*/
+template <typename T>
+class ChaseLevDeque {
+public:
+    static constexpr size_t CAPACITY = 1024;
+
+    static_assert(std::is_trivially_copyable_v<T> && sizeof(T) % sizeof(size_t) == 0,
+                  "ChaseLevDeque stores elements as whole machine words");
+
+    bool push(const T& item) {
+        const long b = bottom.load(std::memory_order_relaxed);
+        const long t = top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<long>(CAPACITY)) {
+            return false;
+        }
+        size_t words[WORDS];
+        std::memcpy(words, &item, sizeof(T));
+        Slot& slot = slots[b & (CAPACITY - 1)];
+        for (size_t w = 0; w < WORDS; ++w) {
+            slot.words[w].store(words[w], std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool pop(T& item) {
+        const long b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        read(b, item);
+        if (t == b) {
+            // Последний элемент: соревнуемся с ворами
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    bool steal(T& item) {
+        long t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const long b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        read(t, item);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t WORDS = sizeof(T) / sizeof(size_t);
+
+    struct Slot {
+        std::atomic<size_t> words[WORDS];
+    };
+
+    void read(long index, T& item) const {
+        const Slot& slot = slots[index & (CAPACITY - 1)];
+        size_t words[WORDS];
+        for (size_t w = 0; w < WORDS; ++w) {
+            words[w] = slot.words[w].load(std::memory_order_relaxed);
+        }
+        std::memcpy(&item, words, sizeof(T));
+    }
+
+    alignas(64) std::atomic<long> top{0};
+    alignas(64) std::atomic<long> bottom{0};
+    Slot slots[CAPACITY];
+};
+
+/*
+Пул с захватом работы. parallel_for(begin, end, grain, fn) кладёт весь диапазон в дек
+вызывающего потока; дальше диапазоны делятся лениво: поток отрезает половину в свой дек
+только когда тот пуст (значит, другим может быть нечего делать), иначе просто выполняет
+очередные grain индексов. Свободный поток ворует сначала у потоков своего разъёма,
+потом у остальных. Медленный или вытесненный поток задерживает не весь join, а только
+свой текущий кусок.
+Ожидание между заданиями и закрепление потоков за cpus - как в ThreadPool.
+*/
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads, std::vector<int> cpus = {})
+        : spinLimit(threads <= static_cast<int>(std::thread::hardware_concurrency())
+                        ? ThreadPool::SPIN_ITERATIONS : ThreadPool::OVERSUBSCRIBED_SPIN_ITERATIONS),
+          cpus(std::move(cpus)), packages(threads) {
+        pin(0);
+        for (int t = 0; t < threads; ++t) {
+            deques.push_back(std::make_unique<ChaseLevDeque<Range>>());
+        }
+        for (int t = 1; t < threads; ++t) {
+            workers.emplace_back(&WorkStealingPool::run, this, t);
+        }
+    }
+
+    ~WorkStealingPool() {
+        stop.store(true);
+        epoch.fetch_add(1);
+        futex::wakeAll(epoch);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, size_t grain, F&& fn) {
+        if (begin >= end) {
+            return;
+        }
+        using Fn = std::remove_reference_t<F>;
+        job.context = const_cast<void*>(static_cast<const void*>(&fn));
+        job.call = [](void* context, size_t first, size_t last) {
+            (*static_cast<Fn*>(context))(first, last);
+        };
+        job.grain = std::max<size_t>(grain, 1);
+        job.total = end - begin;
+        done.store(0, std::memory_order_relaxed);
+        packages[0].store(Topology::instance().currentPackage(), std::memory_order_relaxed);
+        deques[0]->push({begin, end});
+        dispatch();
+    }
+
+    // Зерно по умолчанию: примерно 8 кусков на поток
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, F&& fn) {
+        size_t grain = (end > begin) ? (end - begin) / (8 * static_cast<size_t>(size())) : 1;
+        parallel_for(begin, end, grain, std::forward<F>(fn));
+    }
+
+private:
+    struct Job {
+        size_t grain = 1;
+        size_t total = 0;
+        void* context = nullptr;
+        void (*call)(void*, size_t, size_t) = nullptr;
+    };
+
+    void execute(size_t first, size_t last) {
+        try {
+            job.call(job.context, first, last);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        done.fetch_add(last - first, std::memory_order_acq_rel);
+    }
+
+    // Ленивое двоичное деление
+    void process(int self, Range r) {
+        ChaseLevDeque<Range>& deque = *deques[self];
+        while (r.size() > job.grain) {
+            if (deque.empty()) {
+                size_t mid = r.begin + r.size() / 2;
+                if (deque.push({mid, r.end})) {
+                    r.end = mid;
+                    continue;
+                }
+            }
+            execute(r.begin, r.begin + job.grain);
+            r.begin += job.grain;
+        }
+        execute(r.begin, r.end);
+    }
+
+    // Жертвы: сначала потоки того же разъёма, потом остальные, с случайного места
+    bool steal(int self, std::minstd_rand& gen, Range& r) {
+        const int n = size();
+        const int home = packages[self].load(std::memory_order_relaxed);
+        const int offset = static_cast<int>(gen() % n);
+        for (int pass = 0; pass < 2; ++pass) {
+            for (int k = 0; k < n; ++k) {
+                int victim = (offset + k) % n;
+                if (victim == self || (packages[victim].load(std::memory_order_relaxed) == home) != (pass == 0)) {
+                    continue;
+                }
+                if (deques[victim]->steal(r)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Работать, пока не выполнены все индексы задания
+    void participate(int self) {
+        std::minstd_rand gen(self + 1);
+        Range r;
+        int idle = 0;
+        while (done.load(std::memory_order_acquire) < job.total) {
+            if (deques[self]->pop(r) || steal(self, gen, r)) {
+                process(self, r);
+                idle = 0;
+            } else if (++idle < spinLimit) {
+                cpuRelax();
+            } else {
+                // Долго нечего украсть - отдать процессор тем, у кого работа
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void dispatch() {
+        active.store(static_cast<int>(workers.size()));
+        epoch.fetch_add(1);
+        if (sleeping.load() > 0) {
+            futex::wakeAll(epoch);
+        }
+
+        participate(0);
+
+        // Рабочие ещё могут выходить из participate(): новое задание только после них
+        for (int spin = 0; active.load(std::memory_order_acquire) != 0 && spin < spinLimit; ++spin) {
+            cpuRelax();
+        }
+        if (active.load(std::memory_order_acquire) != 0) {
+            waiting.store(true);
+            int left;
+            while ((left = active.load()) != 0) {
+                futex::wait(active, left);
+            }
+            waiting.store(false);
+        }
+
+        if (error) {
+            std::exception_ptr e = error;
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    void pin(int self) const {
+        if (!cpus.empty()) {
+            pinCurrentThread(cpus[self % cpus.size()]);
+        }
+    }
+
+    void run(int self) {
+        pin(self);
+        int seen = 0;
+        while (true) {
+            int current = seen;
+            for (int spin = 0; spin < spinLimit; ++spin) {
+                current = epoch.load(std::memory_order_acquire);
+                if (current != seen) {
+                    break;
+                }
+                cpuRelax();
+            }
+            if (current == seen) {
+                sleeping.fetch_add(1);
+                while ((current = epoch.load()) == seen) {
+                    futex::wait(epoch, seen);
+                }
+                sleeping.fetch_sub(1);
+            }
+            seen = current;
+            if (stop.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            packages[self].store(Topology::instance().currentPackage(), std::memory_order_relaxed);
+            participate(self);
+
+            if (active.fetch_sub(1) == 1 && waiting.load()) {
+                futex::wakeAll(active);
+            }
+        }
+    }
+
+    const int spinLimit;
+    const std::vector<int> cpus;
+    std::vector<std::atomic<int>> packages;  // разъём каждого участника, подсказка для воров
+    std::vector<std::unique_ptr<ChaseLevDeque<Range>>> deques;
+    std::vector<std::thread> workers;
+    Job job;
+
+    alignas(64) std::atomic<int> epoch{0};
+    alignas(64) std::atomic<size_t> done{0};
+    alignas(64) std::atomic<int> active{0};
+    std::atomic<int> sleeping{0};
+    std::atomic<bool> waiting{false};
+    std::atomic<bool> stop{false};
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
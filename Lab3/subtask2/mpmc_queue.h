@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/*
+Ограниченная очередь для многих производителей и многих потребителей (кольцо Вьюкова).
+У каждой ячейки свой номер последовательности: ячейка pos свободна для записи, когда
+номер равен pos, и готова к чтению, когда он равен pos + 1. Производители и потребители
+занимают позиции одним CAS на своём счётчике и дальше работают только со своей ячейкой,
+поэтому между собой они не мешают, пока очередь не пуста и не полна.
+try_push / try_pop не ждут: полная или пустая очередь - false.
+*/
+template <typename T>
+class MPMCQueue {
+public:
+    // Ёмкость округляется вверх до степени двойки
+    explicit MPMCQueue(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        mask = size - 1;
+        cells = std::make_unique<Cell[]>(size);
+        for (size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MPMCQueue() {
+        T value;
+        while (try_pop(value)) {
+        }
+    }
+
+    MPMCQueue(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    // value перемещается в очередь только при успехе
+    bool try_push(T&& value) {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (dif == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;  // полна
+            } else {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        new (&cell->storage) T(std::move(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_pop(T& value) {
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[pos & mask];
+            const size_t seq = cell->sequence.load(std::memory_order_acquire);
+            const intptr_t dif = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (dif == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;  // пуста
+            } else {
+                pos = dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T* stored = std::launder(reinterpret_cast<T*>(&cell->storage));
+        value = std::move(*stored);
+        stored->~T();
+        // Ячейка свободна для записи на следующем круге
+        cell->sequence.store(pos + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    size_t mask = 0;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<size_t> enqueuePos{0};
+    alignas(64) std::atomic<size_t> dequeuePos{0};
+};
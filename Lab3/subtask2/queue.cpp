@@ -0,0 +1,108 @@
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <chrono>
+#include <fstream>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+#include "mpmc_queue.h"
+
+// Запуск: ./queue [producers] [consumers] [operations]
+// Стоимость одной передачи через очередь: producers потоков кладут по operations чисел,
+// consumers потоков забирают всё. Кольцо Вьюкова (mpmc_queue.h) против std::queue
+// под мьютексом с condition_variable, как было в server.cpp.
+
+// Очередь под мьютексом: блокировка и notify_one на каждую операцию
+struct LockedQueue {
+    bool try_push(size_t&& value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        queue.push(value);
+        cv.notify_one();
+        return true;
+    }
+
+    bool try_pop(size_t& value) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (queue.empty()) {
+            return false;
+        }
+        value = queue.front();
+        queue.pop();
+        return true;
+    }
+
+    std::queue<size_t> queue;
+    std::mutex mutex;
+    std::condition_variable cv;
+};
+
+// Среднее время на одну передачу и контрольная сумма забранного
+template <typename Queue>
+double measure(Queue& queue, int producers, int consumers, size_t operations, size_t& checksum) {
+    const size_t total = operations * producers;
+    std::atomic<size_t> taken{0};
+    std::atomic<size_t> sum{0};
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> team;
+    for (int p = 0; p < producers; ++p) {
+        team.emplace_back([&, p]() {
+            for (size_t i = 0; i < operations; ++i) {
+                size_t value = p * operations + i;
+                while (!queue.try_push(std::move(value))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        team.emplace_back([&]() {
+            size_t local = 0;
+            size_t value;
+            while (taken.load(std::memory_order_relaxed) < total) {
+                if (queue.try_pop(value)) {
+                    local += value;
+                    taken.fetch_add(1, std::memory_order_relaxed);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+            sum.fetch_add(local);
+        });
+    }
+    for (auto& t : team) {
+        t.join();
+    }
+    checksum = sum.load();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() / total;
+}
+
+int main(int argc, char** argv) {
+    const int producers = (argc > 1) ? std::atoi(argv[1]) : 3;
+    const int consumers = (argc > 2) ? std::atoi(argv[2]) : 8;
+    const size_t operations = (argc > 3) ? std::atoi(argv[3]) : 1000000;
+
+    size_t ring_sum = 0, locked_sum = 0;
+    MPMCQueue<size_t> ring(1 << 16);
+    const double ring_seconds = measure(ring, producers, consumers, operations, ring_sum);
+    LockedQueue locked;
+    const double locked_seconds = measure(locked, producers, consumers, operations, locked_sum);
+
+    const size_t total = operations * producers;
+    std::cout << "MPMC ring: " << ring_seconds * 1e9 << " ns per item, mutex queue: " << locked_seconds * 1e9
+              << " ns per item. Checksums " << (ring_sum == locked_sum && ring_sum == total * (total - 1) / 2
+                                                    ? "match." : "DIFFER!") << std::endl;
+
+    std::ofstream file("queue.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    file << producers << "," << consumers << "," << ring_seconds << "," << locked_seconds << std::endl;
+    file.close();
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <utility>
+
+#include "futex.h"
+
+/*
+Хранилище результатов фиксированного размера. Номера задач идут подряд, поэтому
+результат задачи id лежит в ячейке id % capacity; память не растёт, сколько бы задач
+ни прошло через сервер.
+
+Состояние ячейки - одно слово: номер круга (id / capacity), фаза (FREE - результата ещё
+нет, READY - готов) и бит WAITING, если кто-то спит на этом слове в futex.
+  reserve(id)  - ждать, пока результат задачи id - capacity заберут (обычно уже забран);
+  complete(id) - положить результат и одним exchange перевести ячейку в READY, не ожидая
+                 никого; futex-пробуждение - только если кто-то спит;
+  take(id)     - дождаться READY, забрать результат и освободить ячейку для id + capacity.
+Каждый результат забирается ровно один раз. Если результаты не забирать, после capacity
+задач reserve будет ждать.
+*/
+template <typename T>
+class ResultStore {
+public:
+    explicit ResultStore(size_t capacity) : capacity(capacity), slots(std::make_unique<Slot[]>(capacity)) {}
+
+    ~ResultStore() {
+        for (size_t i = 0; i < capacity; ++i) {
+            if ((slots[i].state.load(std::memory_order_relaxed) & PHASE) == READY) {
+                value(slots[i])->~T();
+            }
+        }
+    }
+
+    ResultStore(const ResultStore&) = delete;
+    ResultStore& operator=(const ResultStore&) = delete;
+
+    void reserve(size_t id) {
+        wait(slot(id), word(id, FREE));
+    }
+
+    void complete(size_t id, T result) {
+        Slot& s = slot(id);
+        new (&s.storage) T(std::move(result));
+        publish(s, word(id, READY));
+    }
+
+    T take(size_t id) {
+        Slot& s = slot(id);
+        wait(s, word(id, READY));
+        T* stored = value(s);
+        T result = std::move(*stored);
+        stored->~T();
+        publish(s, word(id + capacity, FREE));
+        return result;
+    }
+
+private:
+    static constexpr int FREE = 0;
+    static constexpr int READY = 1;
+    static constexpr int PHASE = 1;
+    static constexpr int WAITING = 2;
+    static constexpr int SPIN_ITERATIONS = 128;
+
+    struct alignas(64) Slot {
+        std::atomic<int> state{0};  // круг 0, FREE
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    Slot& slot(size_t id) { return slots[id % capacity]; }
+
+    static T* value(Slot& s) { return std::launder(reinterpret_cast<T*>(&s.storage)); }
+
+    // Круг и фаза; 29 бит круга - повтор слова только через 2^29 кругов
+    int word(size_t id, int phase) const {
+        return static_cast<int>(((id / capacity) & 0x1FFFFFFF) << 2) | phase;
+    }
+
+    void publish(Slot& s, int next) {
+        if (s.state.exchange(next, std::memory_order_acq_rel) & WAITING) {
+            futex::wakeAll(s.state);
+        }
+    }
+
+    // Ждать, пока слово ячейки (без бита WAITING) не станет target
+    void wait(Slot& s, int target) {
+        for (int spin = 0; spin < SPIN_ITERATIONS; ++spin) {
+            if ((s.state.load(std::memory_order_acquire) & ~WAITING) == target) {
+                return;
+            }
+            cpuRelax();
+        }
+        int current = s.state.load(std::memory_order_acquire);
+        while ((current & ~WAITING) != target) {
+            if (!(current & WAITING) &&
+                !s.state.compare_exchange_weak(current, current | WAITING, std::memory_order_acquire)) {
+                continue;
+            }
+            futex::wait(s.state, current | WAITING);
+            current = s.state.load(std::memory_order_acquire);
+        }
+    }
+
+    const size_t capacity;
+    std::unique_ptr<Slot[]> slots;
+};
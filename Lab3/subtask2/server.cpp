@@ -1,80 +1,124 @@
 #include <iostream>
 #include <fstream>
 #include <thread>
-#include <queue>
-#include <unordered_map>
-#include <mutex>
-#include <condition_variable>
-#include <future>
+#include <functional>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdlib>
 #include <cmath>
 #include <random>
 
+#include "topology.h"
+#include "futex.h"
+#include "eventcount.h"
+#include "mpmc_queue.h"
+#include "result_store.h"
+
+/*
+Сервер задач: workers рабочих потоков берут задачи из общей очереди.
+Очередь - неблокирующее кольцо Вьюкова (mpmc_queue.h) на capacity задач. Рабочий, которому
+нечего делать, немного крутится, потом засыпает на счётчике событий (common/eventcount.h);
+add_task будит его, только если кто-то спит. Если очередь полна, add_task так же ждёт места.
+Результаты - в кольце из capacity ячеек (result_store.h): ячейка освобождается, когда
+результат забирают через request_result, поэтому каждый результат надо забрать один раз.
+cpus - необязательное размещение (Topology::placement): поток t закрепляется за cpus[t].
+*/
 template<typename T>
 class Server {
 public:
-    Server() : running(false) {}
+    static constexpr size_t QUEUE_CAPACITY = 1 << 12;
+    static constexpr int SPIN_ITERATIONS = 1 << 10;
+
+    explicit Server(int workers = 1, std::vector<int> cpus = {}, size_t capacity = QUEUE_CAPACITY)
+        : workers(workers), cpus(std::move(cpus)), running(false), task_queue(capacity), results(capacity) {}
 
     void start() {
         running = true;
-        server_thread = std::thread(&Server::process_tasks, this);
+        for (int t = 0; t < workers; ++t) {
+            server_threads.emplace_back(&Server::process_tasks, this, t);
+        }
     }
 
+    // Задачи, которые уже в очереди, выполняются до конца
     void stop() {
         running = false;
-        cv.notify_all();
-        if (server_thread.joinable()) {
-            server_thread.join();
+        not_empty.notifyAll();
+        for (auto& thread : server_threads) {
+            thread.join();
         }
+        server_threads.clear();
     }
 
     size_t add_task(std::function<T()> task) {
-        std::unique_lock<std::mutex> lock(task_mutex);
-        size_t id = next_task_id++;
-        task_queue.push({id, task});
-        cv.notify_one();
+        size_t id = next_task_id.fetch_add(1, std::memory_order_relaxed);
+        results.reserve(id);
+        Task item{id, std::move(task)};
+        while (!task_queue.try_push(std::move(item))) {
+            int key = not_full.prepareWait();
+            if (task_queue.try_push(std::move(item))) {
+                not_full.cancelWait();
+                break;
+            }
+            not_full.wait(key);
+        }
+        not_empty.notifyOne();
         return id;
     }
 
     T request_result(size_t id) {
-        std::future<T> future;
-        {
-            std::unique_lock<std::mutex> lock(result_mutex);
-            future = results[id].get_future();
-        }
-        return future.get();
+        return results.take(id);
     }
 
 private:
-    void process_tasks() {
-        while (running) {
-            std::unique_lock<std::mutex> lock(task_mutex);
-            cv.wait(lock, [this]() { return !task_queue.empty() || !running; });
-
-            if (!running && task_queue.empty()) {
-                break;
+    using Task = std::pair<size_t, std::function<T()>>;
+
+    bool next_task(Task& task) {
+        // Крутиться есть смысл, только если клиентам остаются свободные ядра
+        const int spinLimit = (workers < static_cast<int>(std::thread::hardware_concurrency())) ? SPIN_ITERATIONS : 1;
+        while (true) {
+            for (int spin = 0; spin < spinLimit; ++spin) {
+                if (task_queue.try_pop(task)) {
+                    return true;
+                }
+                cpuRelax();
             }
+            int key = not_empty.prepareWait();
+            if (task_queue.try_pop(task)) {
+                not_empty.cancelWait();
+                return true;
+            }
+            if (!running) {
+                not_empty.cancelWait();
+                return false;
+            }
+            not_empty.wait(key);
+        }
+    }
 
-            auto task = task_queue.front();
-            task_queue.pop();
-            lock.unlock();
-
-            T result = task.second();
+    void process_tasks(int worker) {
+        if (!cpus.empty()) {
+            pinCurrentThread(cpus[worker % cpus.size()]);
+        }
+        Task task;
+        while (next_task(task)) {
+            not_full.notifyOne();
 
-            std::unique_lock<std::mutex> res_lock(result_mutex);
-            results[task.first].set_value(result);
+            results.complete(task.first, task.second());
         }
     }
 
-    std::thread server_thread;
-    bool running;
+    const int workers;
+    const std::vector<int> cpus;
+    std::vector<std::thread> server_threads;
+    std::atomic<bool> running;
 
-    std::queue<std::pair<size_t, std::function<T()>>> task_queue;
-    std::unordered_map<size_t, std::promise<T>> results;
-    size_t next_task_id = 0;
-
-    std::mutex task_mutex;
-    std::mutex result_mutex;
-    std::condition_variable cv;
+    MPMCQueue<Task> task_queue;
+    EventCount not_empty;
+    EventCount not_full;
+    ResultStore<T> results;
+    std::atomic<size_t> next_task_id{0};
 };
 
 
@@ -121,10 +165,15 @@ void client_pow(Server<double>& server, int N, const std::string& filename) {
     }
 }
 
-int main() {
-    Server<double> server;
+// Запуск: ./server [workers]
+// PLACEMENT=compact|scatter|one-per-core|node-local закрепляет рабочие потоки (common/topology.h)
+int main(int argc, char** argv) {
+    const int workers = (argc > 1) ? std::atoi(argv[1]) : 1;
+    Server<double> server(workers, placementFromEnv(workers));
     server.start();
 
+    const auto start = std::chrono::steady_clock::now();
+
     const int N = 10000;
     std::thread client1([&server, N]() { client_sin(server, N, "sin_results.txt"); });
     std::thread client2([&server, N]() { client_sqrt(server, N, "sqrt_results.txt"); });
@@ -134,7 +183,18 @@ int main() {
     client2.join();
     client3.join();
 
+    const std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
     server.stop();
 
+    std::cout << "Workers: " << workers << ", time taken for " << 3 * N << " tasks: "
+              << elapsed_seconds.count() << " seconds." << std::endl;
+    std::ofstream file("server.csv", std::ios::app);
+    if (!file.is_open()) {
+        std::cerr << "Error: Unable to open file for writing." << std::endl;
+        return 1;
+    }
+    file << workers << "," << elapsed_seconds.count() << std::endl;
+    file.close();
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <cstddef>
+
+#include "futex.h"
+#include "topology.h"
+
+/*
+Иерархический барьер для команды из threads потоков. Потоки приходят в узлы дерева:
+сначала к SMT-соседям своего ядра, потом к ядрам своего разъёма, потом к остальным
+разъёмам. Последний пришедший в узел поднимается выше, остальные ждут на счётчике
+поколений своего узла. Тот, кто пришёл последним в корень, открывает барьер и будит
+узлы по пути вниз, каждый победитель - свои. Общую кэш-линию на всю машину трогают
+только по одному потоку от разъёма, межпроцессорного трафика почти нет.
+
+cpus - процессоры потоков (Topology::placement), поток t за cpus[t]; без размещения
+дерево строится по номерам потоков, по 4 в узле. Ожидание: сначала кручение, потом futex.
+*/
+class HierarchicalBarrier {
+public:
+    static constexpr int FAN_IN = 4;
+    // Сколько раз проверить поколение, прежде чем уснуть в futex. Если потоков больше,
+    // чем процессоров, кручение только отнимает время у того, кого ждём, - почти сразу спим.
+    static constexpr int SPIN_ITERATIONS = 1 << 14;
+    static constexpr int OVERSUBSCRIBED_SPIN_ITERATIONS = 16;
+
+    explicit HierarchicalBarrier(int threads, const std::vector<int>& cpus = {})
+        : spinLimit(threads <= static_cast<int>(std::thread::hardware_concurrency())
+                        ? SPIN_ITERATIONS : OVERSUBSCRIBED_SPIN_ITERATIONS),
+          leaf(threads, -1) {
+        // Ключи уровней для каждого потока: ядро, разъём
+        std::vector<std::vector<long>> keys(threads);
+        if (!cpus.empty()) {
+            const Topology& topology = Topology::instance();
+            for (int t = 0; t < threads; ++t) {
+                const CpuInfo* c = topology.cpu(cpus[t % cpus.size()]);
+                keys[t] = {c ? c->core : t, c ? c->package : 0};
+            }
+        } else {
+            for (int t = 0; t < threads; ++t) {
+                for (long group = t / FAN_IN, size = FAN_IN; size < threads; group /= FAN_IN, size *= FAN_IN) {
+                    keys[t].push_back(group);
+                }
+            }
+        }
+
+        // Участники текущего уровня: поток (-1 - t) или узел; узел из одного участника не нужен
+        std::vector<int> members(threads);
+        for (int t = 0; t < threads; ++t) {
+            members[t] = -1 - t;
+        }
+        std::vector<int> firstThread(threads);
+        for (int t = 0; t < threads; ++t) {
+            firstThread[t] = t;
+        }
+        for (size_t level = 0; members.size() > 1; ++level) {
+            std::map<long, std::vector<size_t>> groups;
+            for (size_t m = 0; m < members.size(); ++m) {
+                const std::vector<long>& key = keys[firstThread[m]];
+                groups[level < key.size() ? key[level] : 0].push_back(m);
+            }
+            std::vector<int> next;
+            std::vector<int> nextThread;
+            for (auto& group : groups) {
+                if (group.second.size() == 1) {
+                    next.push_back(members[group.second[0]]);
+                    nextThread.push_back(firstThread[group.second[0]]);
+                    continue;
+                }
+                const int node = static_cast<int>(nodes.size());
+                nodes.push_back(std::make_unique<Node>());
+                nodes.back()->expected = static_cast<int>(group.second.size());
+                for (size_t m : group.second) {
+                    attach(members[m], node);
+                }
+                next.push_back(node);
+                nextThread.push_back(firstThread[group.second[0]]);
+            }
+            members.swap(next);
+            firstThread.swap(nextThread);
+        }
+    }
+
+    HierarchicalBarrier(const HierarchicalBarrier&) = delete;
+    HierarchicalBarrier& operator=(const HierarchicalBarrier&) = delete;
+
+    int size() const { return static_cast<int>(leaf.size()); }
+
+    // Число уровней дерева над потоком self
+    int depth(int self) const {
+        int d = 0;
+        for (int node = leaf[self]; node >= 0; node = nodes[node]->parent) {
+            ++d;
+        }
+        return d;
+    }
+
+    // Прийти к барьеру и дождаться всех. Запись до барьера видна всем после него.
+    void wait(int self) {
+        int won[MAX_DEPTH];
+        int count = 0;
+        int node = leaf[self];
+        while (node >= 0) {
+            Node& n = *nodes[node];
+            // Поколение читается до прихода: иначе открытие могло бы проскочить незамеченным
+            const int generation = n.generation.load(std::memory_order_acquire);
+            if (n.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 != n.expected) {
+                await(n, generation);
+                break;
+            }
+            n.arrived.store(0, std::memory_order_relaxed);
+            won[count++] = node;
+            node = n.parent;
+        }
+        // Открыть узлы, где этот поток пришёл последним, сверху вниз
+        while (count > 0) {
+            Node& n = *nodes[won[--count]];
+            n.generation.fetch_add(1);
+            if (n.sleeping.load() > 0) {
+                futex::wakeAll(n.generation);
+            }
+        }
+    }
+
+private:
+    static constexpr int MAX_DEPTH = 32;
+
+    struct Node {
+        alignas(64) std::atomic<int> arrived{0};
+        alignas(64) std::atomic<int> generation{0};
+        std::atomic<int> sleeping{0};
+        int expected = 0;
+        int parent = -1;
+    };
+
+    void attach(int member, int node) {
+        if (member < 0) {
+            leaf[-1 - member] = node;
+        } else {
+            nodes[member]->parent = node;
+        }
+    }
+
+    void await(Node& n, int generation) const {
+        for (int spin = 0; spin < spinLimit; ++spin) {
+            if (n.generation.load(std::memory_order_acquire) != generation) {
+                return;
+            }
+            cpuRelax();
+        }
+        // seq_cst: открывающий либо увидит спящего, либо спящий увидит новое поколение
+        n.sleeping.fetch_add(1);
+        while (n.generation.load() == generation) {
+            futex::wait(n.generation, generation);
+        }
+        n.sleeping.fetch_sub(1);
+    }
+
+    const int spinLimit;
+    std::vector<int> leaf;  // узел, в который приходит поток; -1 - поток один
+    std::vector<std::unique_ptr<Node>> nodes;
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+
+#include "futex.h"
+
+/*
+Счётчик событий (eventcount): усыпить поток до появления работы в неблокирующей
+структуре, не беря блокировок на пути производителя.
+
+Ожидающий:
+    int key = ec.prepareWait();
+    if (есть работа) { ec.cancelWait(); ...забрать... } else { ec.wait(key); }
+Производитель после публикации работы: ec.notifyOne() / ec.notifyAll().
+
+Если спящих нет, notify - одна загрузка после барьера памяти. prepareWait и notify
+упорядочены seq_cst: либо ожидающий при повторной проверке увидит работу, либо
+производитель увидит ожидающего и сдвинет поколение, и wait не уснёт.
+*/
+class EventCount {
+public:
+    int prepareWait() {
+        waiters.fetch_add(1);
+        return epoch.load();
+    }
+
+    void cancelWait() {
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void wait(int key) {
+        while (epoch.load() == key) {
+            futex::wait(epoch, key);
+        }
+        waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notifyOne() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            epoch.fetch_add(1);
+            futex::wakeOne(epoch);
+        }
+    }
+
+    void notifyAll() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) > 0) {
+            epoch.fetch_add(1);
+            futex::wakeAll(epoch);
+        }
+    }
+
+private:
+    alignas(64) std::atomic<int> epoch{0};
+    alignas(64) std::atomic<int> waiters{0};
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <climits>
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+// Ожидание на слове памяти: поток спит в ядре, пока слово равно expected и его не разбудят
+namespace futex {
+
+inline void wait(std::atomic<int>& word, int expected) {
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+inline void wakeOne(std::atomic<int>& word) {
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+}
+
+inline void wakeAll(std::atomic<int>& word) {
+    syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+}  // namespace futex
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
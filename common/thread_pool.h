@@ -0,0 +1,163 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <exception>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "futex.h"
+#include "barrier.h"
+#include "topology.h"
+
+/*
+Пул потоков, которые создаются один раз и живут до конца программы.
+parallel_for(begin, end, fn) делит [begin, end) на size() равных частей и вызывает
+fn(start, stop) для каждой; первую часть выполняет вызывающий поток.
+
+Между заданиями рабочие потоки сначала крутятся на счётчике заданий (ответ за доли
+микросекунды, если задания идут подряд), а потом засыпают в futex и не занимают ядро.
+Завершение задания - иерархический барьер (barrier.h) по ядрам и разъёмам, на котором
+вызывающий поток так же сначала крутится, потом спит.
+cpus - необязательное размещение (Topology::placement): поток t закрепляется за cpus[t],
+вызывающий поток - за cpus[0].
+*/
+
+class ThreadPool {
+public:
+    // Сколько раз проверить флаг, прежде чем уснуть в futex (как в барьере)
+    static constexpr int SPIN_ITERATIONS = HierarchicalBarrier::SPIN_ITERATIONS;
+    static constexpr int OVERSUBSCRIBED_SPIN_ITERATIONS = HierarchicalBarrier::OVERSUBSCRIBED_SPIN_ITERATIONS;
+
+    explicit ThreadPool(int threads, std::vector<int> cpus = {})
+        : spinLimit(threads <= static_cast<int>(std::thread::hardware_concurrency())
+                        ? SPIN_ITERATIONS : OVERSUBSCRIBED_SPIN_ITERATIONS),
+          cpus(std::move(cpus)), barrier(threads, this->cpus) {
+        pin(0);
+        for (int t = 1; t < threads; ++t) {
+            workers.emplace_back(&ThreadPool::run, this, t);
+        }
+    }
+
+    ~ThreadPool() {
+        stop.store(true);
+        epoch.fetch_add(1);
+        futex::wakeAll(epoch);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Число потоков вместе с вызывающим
+    int size() const { return static_cast<int>(workers.size()) + 1; }
+
+    template <typename F>
+    void parallel_for(size_t begin, size_t end, F&& fn) {
+        job.begin = begin;
+        job.end = end;
+        using Fn = std::remove_reference_t<F>;
+        job.context = const_cast<void*>(static_cast<const void*>(&fn));
+        job.call = [](void* context, size_t first, size_t last) {
+            (*static_cast<Fn*>(context))(first, last);
+        };
+        dispatch();
+    }
+
+private:
+    struct Job {
+        size_t begin = 0;
+        size_t end = 0;
+        void* context = nullptr;
+        void (*call)(void*, size_t, size_t) = nullptr;
+    };
+
+    void runPart(int part) {
+        const size_t n = job.end - job.begin;
+        const size_t parts = static_cast<size_t>(size());
+        size_t first = job.begin + n * part / parts;
+        size_t last = job.begin + n * (part + 1) / parts;
+        if (first >= last) {
+            return;
+        }
+        try {
+            job.call(job.context, first, last);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+    }
+
+    void dispatch() {
+        // seq_cst: рабочий, который засыпает, либо увидит новое задание, либо будет разбужен
+        epoch.fetch_add(1);
+        if (sleeping.load() > 0) {
+            futex::wakeAll(epoch);
+        }
+
+        runPart(0);
+        barrier.wait(0);
+
+        if (error) {
+            std::exception_ptr e = error;
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    void pin(int part) const {
+        if (!cpus.empty()) {
+            pinCurrentThread(cpus[part % cpus.size()]);
+        }
+    }
+
+    void run(int part) {
+        pin(part);
+        int seen = 0;  // первое задание - epoch = 1, даже если поток стартовал позже него
+        while (true) {
+            int current = seen;
+            for (int spin = 0; spin < spinLimit; ++spin) {
+                current = epoch.load(std::memory_order_acquire);
+                if (current != seen) {
+                    break;
+                }
+                cpuRelax();
+            }
+            if (current == seen) {
+                sleeping.fetch_add(1);
+                while ((current = epoch.load()) == seen) {
+                    futex::wait(epoch, seen);
+                }
+                sleeping.fetch_sub(1);
+            }
+            seen = current;
+            if (stop.load(std::memory_order_acquire)) {
+                return;
+            }
+
+            runPart(part);
+            barrier.wait(part);
+        }
+    }
+
+    const int spinLimit;
+    const std::vector<int> cpus;
+    HierarchicalBarrier barrier;
+    std::vector<std::thread> workers;
+    Job job;
+
+    // Отдельная строка кэша: счётчик заданий читают все рабочие
+    alignas(64) std::atomic<int> epoch{0};
+    std::atomic<int> sleeping{0};
+    std::atomic<bool> stop{false};
+
+    std::mutex errorMutex;
+    std::exception_ptr error;
+};
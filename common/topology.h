@@ -0,0 +1,321 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <tuple>
+#include <thread>
+#include <cstdlib>
+#include <cstdio>
+#include <cstddef>
+#include <stdexcept>
+
+#include <sched.h>
+#include <pthread.h>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/*
+Топология машины из /sys/devices/system/cpu и /sys/devices/system/node:
+процессоры (логические), ядра, разъёмы, NUMA-узлы, SMT-соседи и кэши.
+На сервере из README: 2 разъёма по 20 ядер, по 2 потока на ядро, узел 0 - процессоры
+0-19 и 40-59, узел 1 - 20-39 и 60-79.
+
+Политики размещения потоков:
+  compact      - заполнять ядро за ядром вместе с SMT-соседями, разъём за разъёмом;
+  scatter      - по кругу по разъёмам, сначала по одному потоку на ядро, потом соседи;
+  one-per-core - только первый поток каждого ядра, SMT не используется;
+  node-local   - только процессоры одного NUMA-узла (по умолчанию - узла вызывающего потока).
+Если потоков больше, чем подходящих процессоров, список идёт по кругу.
+*/
+
+struct CpuInfo {
+    int id = 0;
+    int core = 0;       // номер ядра, уникальный на всю машину
+    int package = 0;
+    int node = 0;
+    int smt = 0;        // номер среди SMT-соседей ядра (0 - первый)
+    std::vector<int> siblings;
+};
+
+struct CacheInfo {
+    int level = 0;
+    std::string type;   // Data, Instruction, Unified
+    size_t size = 0;    // байт
+    int lineSize = 0;
+    std::vector<int> cpus;
+};
+
+enum class Placement { Compact, Scatter, OnePerCore, NodeLocal };
+
+// "0-19,40-59" -> {0, ..., 19, 40, ..., 59}
+inline std::vector<int> parseCpuList(const std::string& text) {
+    std::vector<int> cpus;
+    std::stringstream ss(text);
+    std::string part;
+    while (std::getline(ss, part, ',')) {
+        if (part.empty() || part[0] == '\n') {
+            continue;
+        }
+        size_t dash = part.find('-');
+        int first = std::atoi(part.c_str());
+        int last = (dash == std::string::npos) ? first : std::atoi(part.c_str() + dash + 1);
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+inline Placement placementFromName(const std::string& name) {
+    if (name == "compact") return Placement::Compact;
+    if (name == "scatter") return Placement::Scatter;
+    if (name == "one-per-core") return Placement::OnePerCore;
+    if (name == "node-local") return Placement::NodeLocal;
+    throw std::invalid_argument("unknown placement " + name + " (compact|scatter|one-per-core|node-local)");
+}
+
+class Topology {
+public:
+    std::vector<CpuInfo> cpus;     // по возрастанию id
+    std::vector<CacheInfo> caches;
+
+    // Читается один раз за программу
+    static const Topology& instance() {
+        static const Topology topology = read();
+        return topology;
+    }
+
+    static Topology read(const std::string& root = "/sys/devices/system") {
+        Topology t;
+        std::vector<int> online = parseCpuList(readLine(root + "/cpu/online"));
+        if (online.empty()) {
+            for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); ++cpu) {
+                online.push_back(cpu);
+            }
+        }
+
+        std::map<int, int> nodeOf;
+        for (int node : parseCpuList(readLine(root + "/node/online"))) {
+            for (int cpu : parseCpuList(readLine(root + "/node/node" + std::to_string(node) + "/cpulist"))) {
+                nodeOf[cpu] = node;
+            }
+        }
+
+        std::map<std::pair<int, int>, int> coreIds;  // (разъём, core_id) -> номер ядра
+        std::set<std::tuple<int, std::string, std::string>> seenCaches;
+        for (int id : online) {
+            const std::string dir = root + "/cpu/cpu" + std::to_string(id);
+            CpuInfo cpu;
+            cpu.id = id;
+            cpu.package = readInt(dir + "/topology/physical_package_id", 0);
+            int coreId = readInt(dir + "/topology/core_id", id);
+            auto key = std::make_pair(cpu.package, coreId);
+            if (!coreIds.count(key)) {
+                int next = static_cast<int>(coreIds.size());
+                coreIds[key] = next;
+            }
+            cpu.core = coreIds[key];
+            cpu.node = nodeOf.count(id) ? nodeOf[id] : 0;
+            cpu.siblings = parseCpuList(readLine(dir + "/topology/thread_siblings_list"));
+            if (cpu.siblings.empty()) {
+                cpu.siblings.push_back(id);
+            }
+            cpu.smt = static_cast<int>(std::find(cpu.siblings.begin(), cpu.siblings.end(), id) - cpu.siblings.begin());
+            t.cpus.push_back(cpu);
+
+            for (int index = 0;; ++index) {
+                const std::string cache = dir + "/cache/index" + std::to_string(index);
+                std::string level = readLine(cache + "/level");
+                if (level.empty()) {
+                    break;
+                }
+                std::string type = readLine(cache + "/type");
+                std::string shared = readLine(cache + "/shared_cpu_list");
+                if (!seenCaches.insert({std::atoi(level.c_str()), type, shared}).second) {
+                    continue;
+                }
+                CacheInfo info;
+                info.level = std::atoi(level.c_str());
+                info.type = type;
+                info.size = parseSize(readLine(cache + "/size"));
+                info.lineSize = readInt(cache + "/coherency_line_size", 64);
+                info.cpus = parseCpuList(shared);
+                t.caches.push_back(info);
+            }
+        }
+        return t;
+    }
+
+    int packages() const { return count(&CpuInfo::package); }
+    int nodes() const { return count(&CpuInfo::node); }
+    int cores() const { return count(&CpuInfo::core); }
+    int threadsPerCore() const { return cpus.empty() ? 1 : static_cast<int>(cpus.size()) / std::max(1, cores()); }
+
+    const CpuInfo* cpu(int id) const {
+        for (const CpuInfo& c : cpus) {
+            if (c.id == id) {
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+    // Разъём и узел процессора, на котором сейчас работает поток
+    int currentPackage() const {
+        const CpuInfo* c = cpu(sched_getcpu());
+        return c ? c->package : 0;
+    }
+
+    int currentNode() const {
+        const CpuInfo* c = cpu(sched_getcpu());
+        return c ? c->node : 0;
+    }
+
+    // Кэш уровня level (данных или общий), которым пользуется процессор
+    const CacheInfo* cacheOf(int cpuId, int level) const {
+        for (const CacheInfo& c : caches) {
+            if (c.level == level && c.type != "Instruction" &&
+                std::find(c.cpus.begin(), c.cpus.end(), cpuId) != c.cpus.end()) {
+                return &c;
+            }
+        }
+        return nullptr;
+    }
+
+    // Процессор для каждого из threads потоков
+    std::vector<int> placement(Placement policy, int threads, int node = -1) const {
+        std::vector<const CpuInfo*> order;
+        for (const CpuInfo& c : cpus) {
+            order.push_back(&c);
+        }
+        auto compact = [](const CpuInfo* a, const CpuInfo* b) {
+            return std::tie(a->package, a->core, a->smt) < std::tie(b->package, b->core, b->smt);
+        };
+        std::sort(order.begin(), order.end(), compact);
+
+        if (policy == Placement::Scatter) {
+            // Номер ядра внутри своего разъёма: чередуем разъёмы на каждом шаге
+            std::map<int, int> rank;
+            std::map<int, int> perPackage;
+            for (const CpuInfo* c : order) {
+                if (c->smt == 0) {
+                    rank[c->core] = perPackage[c->package]++;
+                }
+            }
+            std::stable_sort(order.begin(), order.end(), [&](const CpuInfo* a, const CpuInfo* b) {
+                return std::make_tuple(a->smt, rank[a->core], a->package) <
+                       std::make_tuple(b->smt, rank[b->core], b->package);
+            });
+        } else if (policy == Placement::OnePerCore) {
+            order.erase(std::remove_if(order.begin(), order.end(), [](const CpuInfo* c) { return c->smt != 0; }),
+                        order.end());
+        } else if (policy == Placement::NodeLocal) {
+            const int home = (node >= 0) ? node : currentNode();
+            order.erase(std::remove_if(order.begin(), order.end(), [home](const CpuInfo* c) { return c->node != home; }),
+                        order.end());
+        }
+        if (order.empty()) {
+            throw std::invalid_argument("placement: no CPUs match the policy");
+        }
+
+        std::vector<int> result(threads);
+        for (int t = 0; t < threads; ++t) {
+            result[t] = order[t % order.size()]->id;
+        }
+        return result;
+    }
+
+private:
+    static std::string readLine(const std::string& path) {
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);
+        return line;
+    }
+
+    static int readInt(const std::string& path, int fallback) {
+        std::string line = readLine(path);
+        return line.empty() ? fallback : std::atoi(line.c_str());
+    }
+
+    // "32K", "1024K", "28160K", "1M"
+    static size_t parseSize(const std::string& text) {
+        size_t value = static_cast<size_t>(std::atoll(text.c_str()));
+        if (text.find('K') != std::string::npos) value <<= 10;
+        if (text.find('M') != std::string::npos) value <<= 20;
+        return value;
+    }
+
+    int count(int CpuInfo::*field) const {
+        std::set<int> values;
+        for (const CpuInfo& c : cpus) {
+            values.insert(c.*field);
+        }
+        return static_cast<int>(values.size());
+    }
+};
+
+// Закрепить вызывающий поток за процессором
+inline bool pinCurrentThread(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+// Размещение из переменной окружения PLACEMENT; не задана - пустой список (не закреплять)
+inline std::vector<int> placementFromEnv(int threads) {
+    const char* env = std::getenv("PLACEMENT");
+    if (!env || !*env) {
+        return {};
+    }
+    return Topology::instance().placement(placementFromName(env), threads);
+}
+
+#ifdef _OPENMP
+// Значение OMP_PLACES: по одному месту на поток в порядке номеров потоков, "{0},{20},{1}"
+inline std::string openMPPlaces(const std::vector<int>& cpus) {
+    std::string places;
+    for (size_t i = 0; i < cpus.size(); ++i) {
+        places += (i ? ",{" : "{") + std::to_string(cpus[i]) + "}";
+    }
+    return places;
+}
+
+// Закрепить потоки OpenMP: поток i команды - за cpus[i].
+// Надёжно размещение задаёт сама среда OpenMP по OMP_PLACES и OMP_PROC_BIND=close (список
+// печатает ./places), тогда оно действует для вложенных и больших команд и в любой реализации.
+// Если OMP_PLACES задана, она главнее: потоки не трогаются, при расхождении с cpus - предупреждение.
+// Иначе закрепляются потоки текущей команды (libgomp переиспользует их в следующих областях
+// такого же или меньшего размера), а вызывающему потоку возвращается прежняя маска, чтобы
+// создаваемые им потоки не наследовали один процессор.
+inline void pinOpenMPThreads(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return;
+    }
+    const std::string places = openMPPlaces(cpus);
+    const char* current = std::getenv("OMP_PLACES");
+    if (current) {
+        if (places != current) {
+            std::fprintf(stderr, "Warning: OMP_PLACES=%s differs from the requested placement %s, "
+                                 "keeping OMP_PLACES.\n", current, places.c_str());
+        }
+        return;
+    }
+
+    cpu_set_t caller;
+    const bool saved = pthread_getaffinity_np(pthread_self(), sizeof(caller), &caller) == 0;
+    #pragma omp parallel num_threads(static_cast<int>(cpus.size()))
+    pinCurrentThread(cpus[omp_get_thread_num()]);
+    if (saved) {
+        pthread_setaffinity_np(pthread_self(), sizeof(caller), &caller);
+    }
+}
+#endif